@@ -0,0 +1,120 @@
+#ifndef BENCH_BENCH_H
+#define BENCH_BENCH_H
+
+#include "com/usart.h"
+
+#include <microstd/mcu/io.h>
+#include <stdint.h>
+
+/*
+ * Benchmarks run on the target (or in a simulator) and measure the time in CPU cycles with the Timer1 running
+ * without a prescaler. The results are sent over USART, one result per line:
+ *
+ *     <name>,<parameter>,<cycles>
+ *
+ * The last line is `done`.
+ */
+namespace bench {
+
+constexpr uint16_t baudrate = 9600;
+
+/**
+ * @brief The number of runs of every benchmark, the minimum is reported.
+ */
+constexpr uint8_t repeats = 8;
+
+/**
+ * @brief Sink for the values produced by the benchmarked code, so the compiler cannot remove it.
+ */
+inline volatile uint16_t g_sink;
+
+namespace detail {
+
+    inline void send_dec(uint16_t value) {
+        char digits[5];
+        uint8_t size = 0;
+
+        do {
+            digits[size++] = static_cast<char>('0' + (value % 10));
+            value /= 10;
+        } while (value != 0);
+
+        while (size > 0) {
+            com::usart::send(static_cast<uint8_t>(digits[--size]));
+        }
+    }
+
+}
+
+/**
+ * @brief Gets the current cycle count (modulo 2^16).
+ */
+inline uint16_t cycles() { return microstd::mcu::io::Timer1::get_value(); }
+
+/**
+ * @brief Initializes the USART and starts the cycle counter.
+ */
+inline void init() {
+    com::usart::init(baudrate);
+
+    // normal mode without a prescaler
+    microstd::mcu::io::TCCR1A::write(0);
+    microstd::mcu::io::TCCR1B::write<microstd::mcu::io::CS10>();
+}
+
+/**
+ * @brief Measures the number of cycles taken by the function. The function must take less than 2^16 cycles.
+ *
+ * @param fn The benchmarked function.
+ * @return The minimum number of cycles of all runs without the measurement overhead.
+ */
+template <typename Fn> uint16_t measure(Fn fn) {
+    uint16_t overhead = 0xFFFF;
+    uint16_t best     = 0xFFFF;
+
+    for (uint8_t i = 0; i < repeats; ++i) {
+        const uint16_t begin = cycles();
+        const uint16_t end   = cycles();
+
+        if (end - begin < overhead) {
+            overhead = end - begin;
+        }
+    }
+
+    for (uint8_t i = 0; i < repeats; ++i) {
+        const uint16_t begin = cycles();
+        fn();
+        const uint16_t end = cycles();
+
+        if (end - begin < best) {
+            best = end - begin;
+        }
+    }
+
+    return best - overhead;
+}
+
+/**
+ * @brief Sends a single result.
+ *
+ * @param name The benchmark name.
+ * @param param The benchmark parameter (e.g. the number of sensors).
+ * @param cycles The number of cycles.
+ */
+inline void report(const char* name, uint16_t param, uint16_t cycles) {
+    com::usart::send(name);
+    com::usart::send(',');
+    detail::send_dec(param);
+    com::usart::send(',');
+    detail::send_dec(cycles);
+    com::usart::send('\n');
+}
+
+/**
+ * @brief Sends the end marker.
+ */
+inline void done() { com::usart::send("done\n"); }
+
+}
+
+#endif
@@ -0,0 +1,80 @@
+#include "bench.h"
+#include "types/events.h"
+#include "types/index_sequence.h"
+#include "types/sensors.h"
+
+#include <stdint.h>
+
+/*
+ * Runtime sensor dispatch: jump tables of the `SensorsCollection` compared with the linear search by comparing the
+ * sensor index (the previous implementation). The last sensor is used, which is the worst case for the linear search.
+ */
+
+using types::index_sequence;
+using types::make_index_sequence;
+using types::SensorBase;
+using types::SensorFlags;
+
+struct DummyData {
+    uint8_t value;
+};
+
+template <uint8_t N> struct DummySensor : SensorBase<DummyData, SensorFlags::HAS_ENABLE> {
+    static optional_data_t measure() { return optional_data_t::some(DummyData { .value = N }); }
+
+    static void enable() { bench::g_sink = N; }
+
+    static void disable() { bench::g_sink = 0; }
+
+    static void usart_send(const data_t& data) { bench::g_sink = data.value; }
+};
+
+template <typename Seq> struct collection;
+
+template <uint8_t... Is> struct collection<index_sequence<Is...>> {
+    using type = types::SensorsCollection<1, DummySensor<Is>...>;
+};
+
+template <uint8_t N> using collection_t = typename collection<make_index_sequence<N>>::type;
+
+template <uint8_t N, uint8_t I = 0> void linear_send(const collection_t<N>& sensors, uint8_t i) {
+    using sensor_t = typename collection_t<N>::template sensor_get_t<I>;
+
+    if (I == i) {
+        sensor_t::usart_send(sensors.template measure<I>());
+    } else if constexpr (I + 1 < N) {
+        linear_send<N, I + 1>(sensors, i);
+    }
+}
+
+template <uint8_t N> void run() {
+    static collection_t<N> sensors;
+    types::EventQueue<1> events;
+
+    sensors.init();
+    sensors.measure_all(events, 0);
+
+    volatile uint8_t id = N - 1;
+
+    bench::report("dispatch.send", N, bench::measure([&] { sensors.usart_send(id); }));
+    bench::report("linear.send", N, bench::measure([&] { linear_send<N>(sensors, id); }));
+    bench::report("dispatch.enable", N, bench::measure([&] { sensors.enable(id); }));
+    bench::report("dispatch.disable", N, bench::measure([&] { sensors.disable(id); }));
+
+    bench::report("dispatch.measure", N, bench::measure([&] {
+                      types::event_t event;
+                      sensors.measure_single(id, event);
+                  }));
+}
+
+int main() {
+    bench::init();
+
+    run<2>();
+    run<16>();
+    run<64>();
+
+    bench::done();
+
+    while (true) { }
+}
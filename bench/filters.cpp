@@ -0,0 +1,57 @@
+#include "bench.h"
+#include "types/filters.h"
+
+#include <stdint.h>
+
+/*
+ * Filter stages: cycles per sample of every stage and of the whole pipeline used by the joystick. The parameter is the
+ * field width in bits, `filter.none` is the cost of the input generation.
+ */
+
+using types::Deadband;
+using types::EMA;
+using types::filter_chain;
+using types::Median;
+
+namespace {
+
+// pseudo random input with an occasional spike
+uint16_t next_sample() {
+    static uint16_t state = 0xACE1;
+    state ^= state << 7;
+    state ^= state >> 9;
+    state ^= state << 8;
+
+    return ((state & 0x3F) == 0) ? 1023 : (512 + (state & 0xF));
+}
+
+template <typename... Stages> void run(const char* name) {
+    static filter_chain<uint16_t, Stages...> chain;
+
+    // fill the stage state
+    for (uint8_t i = 0; i < 16; ++i) {
+        chain.apply(next_sample());
+    }
+
+    bench::report(name, 16, bench::measure([&] {
+                      const uint16_t sample = next_sample();
+                      bench::g_sink         = chain.apply(sample);
+                  }));
+}
+
+}
+
+int main() {
+    bench::init();
+
+    run<>("filter.none");
+    run<Median<3>>("filter.median3");
+    run<Median<5>>("filter.median5");
+    run<EMA<1, 4>>("filter.ema1_4");
+    run<Deadband<4>>("filter.deadband4");
+    run<Median<3>, EMA<1, 4>, Deadband<4>>("filter.pipeline");
+
+    bench::done();
+
+    while (true) { }
+}
@@ -0,0 +1,93 @@
+#include "mock/usart.h"
+#include "types/events.h"
+#include "types/index_sequence.h"
+#include "types/sensors.h"
+
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+
+/*
+ * Runtime sensor dispatch through the jump tables of the `SensorsCollection`, the last sensor is used (see
+ * bench/dispatch.cpp for the AVR cycles).
+ */
+
+namespace {
+
+using types::index_sequence;
+using types::make_index_sequence;
+using types::SensorBase;
+using types::SensorFlags;
+
+struct DummyData {
+    uint8_t value;
+};
+
+template <uint8_t N> struct DummySensor : SensorBase<DummyData, SensorFlags::HAS_ENABLE> {
+    static optional_data_t measure() { return optional_data_t::some(DummyData { .value = N }); }
+
+    static void enable() { }
+
+    static void disable() { }
+
+    static void usart_send(const data_t& data) { com::usart::send(data.value); }
+};
+
+template <typename Seq> struct collection;
+
+template <uint8_t... Is> struct collection<index_sequence<Is...>> {
+    using type = types::SensorsCollection<1, DummySensor<Is>...>;
+};
+
+template <uint8_t N> using collection_t = typename collection<make_index_sequence<N>>::type;
+
+template <uint8_t N> collection_t<N>& sensors() {
+    static collection_t<N> s_sensors;
+
+    mock::usart::init();
+
+    types::EventQueue<1> events;
+    s_sensors.init();
+    s_sensors.measure_all(events, 0);
+
+    return s_sensors;
+}
+
+template <uint8_t N> void BM_DispatchSend(benchmark::State& state) {
+    auto& collection = sensors<N>();
+
+    for (auto _ : state) {
+        collection.usart_send(N - 1);
+        mock::usart::g_sent.clear();
+    }
+}
+
+template <uint8_t N> void BM_DispatchEnable(benchmark::State& state) {
+    auto& collection = sensors<N>();
+
+    for (auto _ : state) {
+        collection.enable(N - 1);
+    }
+}
+
+template <uint8_t N> void BM_DispatchMeasure(benchmark::State& state) {
+    auto& collection = sensors<N>();
+
+    for (auto _ : state) {
+        types::event_t event;
+        benchmark::DoNotOptimize(collection.measure_single(N - 1, event));
+    }
+}
+
+}
+
+BENCHMARK_TEMPLATE(BM_DispatchSend, 2);
+BENCHMARK_TEMPLATE(BM_DispatchSend, 16);
+BENCHMARK_TEMPLATE(BM_DispatchSend, 64);
+
+BENCHMARK_TEMPLATE(BM_DispatchEnable, 2);
+BENCHMARK_TEMPLATE(BM_DispatchEnable, 16);
+BENCHMARK_TEMPLATE(BM_DispatchEnable, 64);
+
+BENCHMARK_TEMPLATE(BM_DispatchMeasure, 2);
+BENCHMARK_TEMPLATE(BM_DispatchMeasure, 16);
+BENCHMARK_TEMPLATE(BM_DispatchMeasure, 64);
@@ -0,0 +1,98 @@
+#include "app.h"
+#include "mock/usart.h"
+#include "types/fields.h"
+#include "types/sensors.h"
+
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+#include <string_view>
+
+/*
+ * The command protocol of the `App`: the bytes are received by the mock USART and the state machine runs until the
+ * response is sent.
+ */
+
+namespace {
+
+using types::SensorBase;
+using types::SensorFlags;
+
+struct LevelData {
+    int16_t level;
+};
+
+struct LevelSensor : SensorBase<LevelData, SensorFlags::HAS_ENABLE, types::fields<&LevelData::level>> {
+    static optional_data_t measure() { return optional_data_t::some(LevelData { .level = 120 }); }
+
+    static void enable() { }
+
+    static void disable() { }
+};
+
+using app_t = App<false, 16, LevelSensor, LevelSensor>;
+
+app_t& app() {
+    static app_t s_app;
+    static bool s_started = false;
+
+    if (!s_started) {
+        mock::usart::init();
+        s_app.begin(9600);
+        s_started = true;
+    }
+
+    return s_app;
+}
+
+void command(app_t& target, std::string_view bytes) {
+    mock::usart::feed(bytes);
+
+    do {
+        target.step();
+    } while (!mock::usart::g_received.empty() || !target.idle());
+
+    mock::usart::g_sent.clear();
+}
+
+void BM_ParseEnable(benchmark::State& state) {
+    auto& target = app();
+
+    for (auto _ : state) {
+        command(target, "e001");
+    }
+}
+
+void BM_ParseSetInterval(benchmark::State& state) {
+    auto& target = app();
+
+    for (auto _ : state) {
+        command(target, "s05s");
+    }
+}
+
+void BM_ParseCalibration(benchmark::State& state) {
+    auto& target = app();
+
+    // c2 = 0, c1 = 3, offset = -2, divisor = 2 and the checksum of the 8 bytes
+    constexpr char CALIBRATION[] = { 'k', '0', '0', '1', '0', '0', '0', 0x00, 0x00, 0x00, 0x03,
+                                     '\xFF', '\xFE', 0x00, 0x02, 0x02 };
+
+    for (auto _ : state) {
+        command(target, std::string_view(CALIBRATION, sizeof(CALIBRATION)));
+    }
+}
+
+void BM_ParseUnknown(benchmark::State& state) {
+    auto& target = app();
+
+    for (auto _ : state) {
+        command(target, "x");
+    }
+}
+
+}
+
+BENCHMARK(BM_ParseEnable);
+BENCHMARK(BM_ParseSetInterval);
+BENCHMARK(BM_ParseCalibration);
+BENCHMARK(BM_ParseUnknown);
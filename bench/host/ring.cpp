@@ -0,0 +1,61 @@
+#include "types/events.h"
+#include "types/fields.h"
+#include "types/sensors.h"
+
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+
+/*
+ * Insertion of a measurement into the ring buffer cache of a sensor, with every value cached and with the repeated
+ * values counted by the deduplication.
+ */
+
+namespace {
+
+using types::SensorBase;
+using types::SensorFlags;
+
+struct CounterData {
+    uint16_t value;
+};
+
+using counter_fields_t = types::fields<&CounterData::value>;
+
+// every measurement is a new value
+struct CounterSensor : SensorBase<CounterData, SensorFlags::NONE, counter_fields_t> {
+    static optional_data_t measure() {
+        s_value += 1;
+        return optional_data_t::some(CounterData { .value = s_value });
+    }
+
+private:
+    static inline uint16_t s_value = 0;
+};
+
+// every measurement repeats the cached value
+struct ConstantSensor : SensorBase<CounterData, SensorFlags::HAS_DEDUP, counter_fields_t> {
+    static constexpr uint16_t dedup_band = 0;
+
+    static optional_data_t measure() { return optional_data_t::some(CounterData { .value = 42 }); }
+};
+
+template <typename Sensor, uint16_t CacheSize> void BM_CacheInsert(benchmark::State& state) {
+    static types::SensorsCollection<CacheSize, Sensor> s_sensors;
+    types::EventQueue<1> events;
+
+    s_sensors.init();
+
+    for (auto _ : state) {
+        s_sensors.measure_all(events, 0);
+    }
+}
+
+}
+
+BENCHMARK_TEMPLATE(BM_CacheInsert, CounterSensor, 8);
+BENCHMARK_TEMPLATE(BM_CacheInsert, CounterSensor, 64);
+BENCHMARK_TEMPLATE(BM_CacheInsert, CounterSensor, 256);
+
+BENCHMARK_TEMPLATE(BM_CacheInsert, ConstantSensor, 8);
+BENCHMARK_TEMPLATE(BM_CacheInsert, ConstantSensor, 64);
+BENCHMARK_TEMPLATE(BM_CacheInsert, ConstantSensor, 256);
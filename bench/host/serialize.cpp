@@ -0,0 +1,113 @@
+#include "mock/usart.h"
+#include "types/events.h"
+#include "types/fields.h"
+#include "types/format.h"
+#include "types/sensor_meta.h"
+#include "types/sensors.h"
+
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+
+/*
+ * Serialization of the cached samples: the full history and its run-length encoding sent by the USART and the
+ * formatting of the latest sample for the display.
+ */
+
+namespace {
+
+using types::field_meta_t;
+using types::SensorBase;
+using types::SensorFlags;
+using types::sensor_meta_t;
+
+struct PairData {
+    int16_t a;
+    uint8_t b;
+};
+
+using pair_fields_t = types::fields<&PairData::a, &PairData::b>;
+
+struct PairSensor : SensorBase<PairData, SensorFlags::NONE, pair_fields_t> {
+    static constexpr sensor_meta_t meta PROGMEM = { .name = "pair" };
+
+    static constexpr field_meta_t fields_meta[] PROGMEM = {
+        SENSOR_FIELD(PairData, a, "raw", -1),
+        SENSOR_FIELD(PairData, b, "raw", 0),
+    };
+
+    static optional_data_t measure() {
+        // a few repeated values, so the run-length encoding has runs to merge
+        s_count += 1;
+        return optional_data_t::some(PairData { .a = static_cast<int16_t>(s_count / 4), .b = 7 });
+    }
+
+private:
+    static inline uint16_t s_count = 0;
+};
+
+constexpr uint16_t CACHE_SIZE = 64;
+
+using collection_t = types::SensorsCollection<CACHE_SIZE, PairSensor>;
+
+collection_t& sensors() {
+    static collection_t s_sensors;
+
+    mock::usart::init();
+
+    types::EventQueue<1> events;
+    s_sensors.init();
+
+    for (uint16_t i = 0; i < CACHE_SIZE; ++i) {
+        s_sensors.measure_all(events, 0);
+    }
+
+    return s_sensors;
+}
+
+void BM_SendAll(benchmark::State& state) {
+    auto& collection = sensors();
+
+    size_t sent = 0;
+
+    for (auto _ : state) {
+        collection.usart_send_all(0);
+
+        sent += mock::usart::g_sent.size();
+        mock::usart::g_sent.clear();
+    }
+
+    state.counters["bytes"] = benchmark::Counter(static_cast<double>(sent), benchmark::Counter::kAvgIterations);
+}
+
+void BM_SendRle(benchmark::State& state) {
+    auto& collection = sensors();
+
+    size_t sent = 0;
+
+    for (auto _ : state) {
+        collection.usart_send_rle(0);
+
+        sent += mock::usart::g_sent.size();
+        mock::usart::g_sent.clear();
+    }
+
+    state.counters["bytes"] = benchmark::Counter(static_cast<double>(sent), benchmark::Counter::kAvgIterations);
+}
+
+void BM_FormatLatest(benchmark::State& state) {
+    auto& collection = sensors();
+
+    for (auto _ : state) {
+        char text[22];
+        types::text_writer_t out(text, sizeof(text));
+
+        collection.format_latest(0, out);
+        benchmark::DoNotOptimize(text);
+    }
+}
+
+}
+
+BENCHMARK(BM_SendAll);
+BENCHMARK(BM_SendRle);
+BENCHMARK(BM_FormatLatest);
@@ -0,0 +1,66 @@
+#include "vm/vm.h"
+
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+
+/*
+ * Verification, loading and execution of an uploaded watch program: "the sample of the sensor 0 is above 25.0".
+ */
+
+namespace {
+
+constexpr uint8_t PROGRAM[] = {
+    static_cast<uint8_t>(vm::Op::LOAD_I16), 0, 0, 0,    // the latest sample of the sensor 0
+    static_cast<uint8_t>(vm::Op::PUSH16),   0x00, 0xFA, // 250
+    static_cast<uint8_t>(vm::Op::GT),
+    static_cast<uint8_t>(vm::Op::JZ),       2,          // to the HALT
+    static_cast<uint8_t>(vm::Op::PUSH8),    1,
+    static_cast<uint8_t>(vm::Op::HALT),
+};
+
+bool load_sample(void*, uint8_t, uint8_t, uint8_t, uint8_t size, uint8_t* out) {
+    // 26.0 C, little-endian as on the AVR
+    constexpr uint8_t SAMPLE[] = { 0x04, 0x01 };
+
+    for (uint8_t i = 0; i < size && i < sizeof(SAMPLE); ++i) {
+        out[i] = SAMPLE[i];
+    }
+
+    return true;
+}
+
+void BM_VmVerify(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(vm::Machine::verify(PROGRAM, sizeof(PROGRAM), 1));
+    }
+}
+
+void BM_VmLoad(benchmark::State& state) {
+    vm::Machine machine;
+    machine.init(vm::VmAdapter { .ctx = nullptr, .load = load_sample, .sensors_count = 1 });
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(machine.load(PROGRAM, sizeof(PROGRAM)));
+    }
+}
+
+void BM_VmRun(benchmark::State& state) {
+    vm::Machine machine;
+    machine.init(vm::VmAdapter { .ctx = nullptr, .load = load_sample, .sensors_count = 1 });
+    machine.load(PROGRAM, sizeof(PROGRAM));
+
+    for (auto _ : state) {
+        machine.run();
+        benchmark::DoNotOptimize(machine.result());
+    }
+
+    if (machine.status() != vm::Status::OK || machine.result() != 1) {
+        state.SkipWithError("the program returned a wrong result");
+    }
+}
+
+}
+
+BENCHMARK(BM_VmVerify);
+BENCHMARK(BM_VmLoad);
+BENCHMARK(BM_VmRun);
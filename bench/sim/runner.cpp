@@ -0,0 +1,558 @@
+#include <avr_adc.h>
+#include <avr_ioport.h>
+#include <avr_twi.h>
+#include <avr_uart.h>
+#include <sim_avr.h>
+#include <sim_cycle_timers.h>
+#include <sim_elf.h>
+#include <sim_io.h>
+#include <sim_irq.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*
+ * Runs the traced firmware in simavr and reports the cycles of the scripted scenarios.
+ *
+ *     sim_runner --firmware <elf> [--out <csv>] <scenario>...
+ *
+ * The firmware is connected to a simulated DHT11 (PD7), joystick (ADC5, ADC4), rotary encoder (PD2, PD3, button on
+ * PD4) and SSD1306 (TWI address 0x3C). Every scenario is a text file with one step per line:
+ *
+ *     wait <ms>               runs the simulation
+ *     request <name> <bytes>  sends the bytes over USART and waits for the whole response
+ *     expect <bytes>          checks the last response
+ *     dht <tenths>            sets the temperature of the DHT11 in tenths of degree Celsius
+ *     adc <channel> <mV>      sets the voltage of the ADC input
+ *     turn <steps>            turns the encoder, a negative number turns it down
+ *     click                   presses and releases the button
+ *     repeat <count> ... end  repeats the steps
+ *
+ * The bytes may contain the escapes `\n`, `\\` and `\xHH`, `#` starts a comment. The results are CSV lines with the
+ * distribution of every request and every trace span (see `include/trace.h`) in CPU cycles:
+ *
+ *     scenario,metric,count,min,p50,p90,p99,max
+ */
+
+namespace {
+
+constexpr uint32_t DEFAULT_FREQUENCY = 16000000;
+constexpr uint32_t BAUDRATE          = 9600;
+
+// the response ends when the USART is idle for the time of 4 bytes
+constexpr uint32_t RESPONSE_IDLE_US    = 4 * 10 * 1000000 / BAUDRATE;
+constexpr uint32_t RESPONSE_TIMEOUT_MS = 5000;
+
+// ATmega328P General Purpose I/O Register 0, written by the trace markers
+constexpr avr_io_addr_t TRACE_REGISTER = 0x3E;
+constexpr uint8_t TRACE_END            = 0x80;
+
+constexpr const char* SPAN_NAMES[] = { nullptr, "span.measure", "span.ui_update", "span.command" };
+constexpr uint8_t SPAN_COUNT       = sizeof(SPAN_NAMES) / sizeof(SPAN_NAMES[0]);
+
+constexpr int DHT_PIN     = 7;
+constexpr int ENCODER_DT  = 2;
+constexpr int ENCODER_CLK = 3;
+constexpr int BUTTON_PIN  = 4;
+
+// the same pins as the firmware (src/main.cpp, include/input.h), the DHT11 must not share a pin with the input
+static_assert(DHT_PIN != ENCODER_DT && DHT_PIN != ENCODER_CLK && DHT_PIN != BUTTON_PIN);
+
+constexpr uint8_t DISPLAY_ADDRESS = 0x3C;
+
+void fail(const std::string& msg) {
+    std::fprintf(stderr, "\x1b[31mERROR: %s\x1b[0m\n", msg.c_str());
+    std::exit(1);
+}
+
+struct Simulator {
+    avr_t* avr = nullptr;
+
+    avr_irq_t* uart_in      = nullptr;
+    avr_irq_t* port_d[8]    = {};
+    avr_irq_t* adc[8]       = {};
+    avr_irq_t* twi_in       = nullptr;
+    bool display_selected   = false;
+    uint8_t encoder_state   = 0;
+
+    // USART
+    std::vector<uint8_t> pending;
+    std::string response;
+    avr_cycle_count_t last_tx = 0;
+
+    // DHT11
+    int16_t dht_tenths             = 235;
+    uint8_t ddr_d                  = 0;
+    uint8_t port_d_value           = 0;
+    bool dht_pulled                = false;
+    avr_cycle_count_t dht_low_from = 0;
+    std::vector<std::pair<uint32_t, uint32_t>> dht_wave; // duration in us and the level
+    size_t dht_step = 0;
+
+    // trace spans and requests
+    std::array<avr_cycle_count_t, SPAN_COUNT> span_begin = {};
+    std::map<std::string, std::vector<avr_cycle_count_t>> samples;
+
+    avr_cycle_count_t us_to_cycles(uint64_t us) const { return (us * avr->frequency) / 1000000; }
+};
+
+// ------------------------------------------------------------------------------
+// Simulation
+
+void run_until(Simulator& sim, avr_cycle_count_t cycle) {
+    while (sim.avr->cycle < cycle) {
+        const int state = avr_run(sim.avr);
+        if (state == cpu_Done || state == cpu_Crashed) {
+            fail("the firmware stopped");
+        }
+    }
+}
+
+void run_ms(Simulator& sim, uint32_t ms) { run_until(sim, sim.avr->cycle + sim.us_to_cycles(ms * 1000ULL)); }
+
+void set_pin(Simulator& sim, int pin, bool level) { avr_raise_irq(sim.port_d[pin], level ? 1 : 0); }
+
+// ------------------------------------------------------------------------------
+// USART
+
+avr_cycle_count_t uart_feed(avr_t* avr, avr_cycle_count_t when, void* param) {
+    auto& sim = *static_cast<Simulator*>(param);
+    if (sim.pending.empty()) {
+        return 0;
+    }
+
+    avr_raise_irq(sim.uart_in, sim.pending.front());
+    sim.pending.erase(sim.pending.begin());
+
+    // one byte every frame (start bit, 8 data bits and stop bit)
+    return sim.pending.empty() ? 0 : when + avr_usec_to_cycles(avr, 10 * 1000000 / BAUDRATE);
+}
+
+void uart_output(avr_irq_t*, uint32_t value, void* param) {
+    auto& sim = *static_cast<Simulator*>(param);
+    sim.response.push_back(static_cast<char>(value));
+    sim.last_tx = sim.avr->cycle;
+}
+
+/**
+ * @return The cycles from the first byte of the request to the last byte of the response.
+ */
+avr_cycle_count_t request(Simulator& sim, const std::string& bytes) {
+    sim.response.clear();
+    sim.pending.assign(bytes.begin(), bytes.end());
+
+    const avr_cycle_count_t start = sim.avr->cycle;
+    sim.last_tx                   = start;
+    avr_cycle_timer_register(sim.avr, 1, uart_feed, &sim);
+
+    const avr_cycle_count_t idle    = sim.us_to_cycles(RESPONSE_IDLE_US);
+    const avr_cycle_count_t timeout = start + sim.us_to_cycles(RESPONSE_TIMEOUT_MS * 1000ULL);
+
+    while (sim.avr->cycle < timeout) {
+        run_until(sim, sim.avr->cycle + idle);
+
+        if (!sim.response.empty() && sim.avr->cycle - sim.last_tx >= idle) {
+            return sim.last_tx - start;
+        }
+    }
+
+    fail("no response to the request");
+    return 0;
+}
+
+// ------------------------------------------------------------------------------
+// DHT11
+
+avr_cycle_count_t dht_next(avr_t* avr, avr_cycle_count_t when, void* param) {
+    auto& sim = *static_cast<Simulator*>(param);
+    if (sim.dht_step >= sim.dht_wave.size()) {
+        return 0;
+    }
+
+    const auto [us, level] = sim.dht_wave[sim.dht_step++];
+    set_pin(sim, DHT_PIN, level != 0);
+
+    return when + avr_usec_to_cycles(avr, us);
+}
+
+void dht_respond(Simulator& sim) {
+    const int16_t tenths  = sim.dht_tenths < 0 ? static_cast<int16_t>(-sim.dht_tenths) : sim.dht_tenths;
+    const uint8_t humid   = 45;
+    const auto temp_int   = static_cast<uint8_t>(tenths / 10);
+    const auto temp_dec   = static_cast<uint8_t>((tenths % 10) | (sim.dht_tenths < 0 ? 0x80 : 0));
+    const uint8_t bytes[] = { humid, 0, temp_int, temp_dec, static_cast<uint8_t>(humid + temp_int + temp_dec) };
+
+    // the response starts 10 us after the release (the MCU waits at most 20 us) with 80 us low and 80 us high
+    sim.dht_wave = { { 10, 1 }, { 80, 0 }, { 80, 1 } };
+    for (const uint8_t byte : bytes) {
+        for (int bit = 7; bit >= 0; --bit) {
+            sim.dht_wave.emplace_back(50, 0);
+            sim.dht_wave.emplace_back(((byte >> bit) & 1) != 0 ? 70 : 26, 1);
+        }
+    }
+    sim.dht_wave.emplace_back(50, 0);
+    sim.dht_wave.emplace_back(0, 1);
+
+    sim.dht_step = 0;
+    avr_cycle_timer_register(sim.avr, 1, dht_next, &sim);
+}
+
+/**
+ * @brief The MCU pulls the line low for the start signal, the sensor responds when the line is released.
+ */
+void dht_line_changed(Simulator& sim) {
+    const bool pulled = (sim.ddr_d & (1 << DHT_PIN)) != 0 && (sim.port_d_value & (1 << DHT_PIN)) == 0;
+    if (pulled == sim.dht_pulled) {
+        return;
+    }
+
+    sim.dht_pulled = pulled;
+    if (pulled) {
+        sim.dht_low_from = sim.avr->cycle;
+    } else if (sim.avr->cycle - sim.dht_low_from >= sim.us_to_cycles(18000)) {
+        dht_respond(sim);
+    }
+}
+
+void port_d_written(avr_irq_t*, uint32_t value, void* param) {
+    auto& sim        = *static_cast<Simulator*>(param);
+    sim.port_d_value = static_cast<uint8_t>(value);
+    dht_line_changed(sim);
+}
+
+void ddr_d_written(avr_irq_t*, uint32_t value, void* param) {
+    auto& sim = *static_cast<Simulator*>(param);
+    sim.ddr_d = static_cast<uint8_t>(value);
+    dht_line_changed(sim);
+}
+
+// ------------------------------------------------------------------------------
+// Encoder
+
+/**
+ * @brief Turns the encoder by one transition, two transitions are one step of the UI.
+ */
+void encoder_transition(Simulator& sim, bool up) {
+    // the states CLK << 1 | DT in the order of turning up
+    constexpr uint8_t ORDER[] = { 0b00, 0b10, 0b11, 0b01 };
+
+    uint8_t index = 0;
+    while (ORDER[index] != sim.encoder_state) {
+        ++index;
+    }
+
+    sim.encoder_state = ORDER[(index + (up ? 1 : 3)) % 4];
+    set_pin(sim, ENCODER_CLK, (sim.encoder_state & 0b10) != 0);
+    set_pin(sim, ENCODER_DT, (sim.encoder_state & 0b01) != 0);
+
+    run_ms(sim, 2);
+}
+
+// ------------------------------------------------------------------------------
+// SSD1306, every byte is acknowledged and dropped
+
+void twi_output(avr_irq_t*, uint32_t value, void* param) {
+    auto& sim = *static_cast<Simulator*>(param);
+
+    avr_twi_msg_irq_t msg;
+    msg.u.v = value;
+
+    if ((msg.u.twi.msg & TWI_COND_STOP) != 0) {
+        sim.display_selected = false;
+    }
+
+    if ((msg.u.twi.msg & TWI_COND_START) != 0) {
+        sim.display_selected = (msg.u.twi.addr >> 1) == DISPLAY_ADDRESS;
+    }
+
+    if (sim.display_selected && (msg.u.twi.msg & (TWI_COND_START | TWI_COND_WRITE)) != 0) {
+        avr_raise_irq(sim.twi_in, avr_twi_irq_msg(TWI_COND_ACK, msg.u.twi.addr, 1));
+    }
+}
+
+// ------------------------------------------------------------------------------
+// Trace
+
+void trace_written(avr_t* avr, avr_io_addr_t addr, uint8_t value, void* param) {
+    auto& sim       = *static_cast<Simulator*>(param);
+    avr->data[addr] = value;
+
+    const uint8_t span = value & ~TRACE_END;
+    if (span == 0 || span >= SPAN_COUNT) {
+        return;
+    }
+
+    if ((value & TRACE_END) == 0) {
+        sim.span_begin[span] = avr->cycle;
+    } else if (sim.span_begin[span] != 0) {
+        sim.samples[SPAN_NAMES[span]].push_back(avr->cycle - sim.span_begin[span]);
+        sim.span_begin[span] = 0;
+    }
+}
+
+// ------------------------------------------------------------------------------
+
+void attach(Simulator& sim) {
+    avr_t* avr = sim.avr;
+
+    uint32_t flags = 0;
+    avr_ioctl(avr, AVR_IOCTL_UART_GET_FLAGS('0'), &flags);
+    flags &= ~AVR_UART_FLAG_STDIO;
+    avr_ioctl(avr, AVR_IOCTL_UART_SET_FLAGS('0'), &flags);
+
+    sim.uart_in = avr_io_getirq(avr, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_INPUT);
+    avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_OUTPUT), uart_output, &sim);
+
+    for (int i = 0; i < 8; ++i) {
+        sim.port_d[i] = avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('D'), i);
+        sim.adc[i]    = avr_io_getirq(avr, AVR_IOCTL_ADC_GETIRQ, ADC_IRQ_ADC0 + i);
+    }
+
+    avr_irq_t* port_irqs = avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('D'), 0);
+    avr_irq_register_notify(port_irqs + IOPORT_IRQ_REG_PORT, port_d_written, &sim);
+    avr_irq_register_notify(port_irqs + IOPORT_IRQ_DIRECTION_ALL, ddr_d_written, &sim);
+
+    sim.twi_in = avr_io_getirq(avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_INPUT);
+    avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_OUTPUT), twi_output, &sim);
+
+    avr_register_io_write(avr, TRACE_REGISTER, trace_written, &sim);
+
+    // idle inputs: the encoder at rest, the button and the DHT11 line released and the joystick centered
+    set_pin(sim, ENCODER_CLK, false);
+    set_pin(sim, ENCODER_DT, false);
+    set_pin(sim, BUTTON_PIN, true);
+    set_pin(sim, DHT_PIN, true);
+    avr_raise_irq(sim.adc[5], 2500);
+    avr_raise_irq(sim.adc[4], 2500);
+}
+
+/**
+ * @brief Loads the firmware, the simulator must not be moved afterwards (the callbacks point to it).
+ */
+void load(Simulator& sim, const std::string& firmware_path) {
+    elf_firmware_t firmware = {};
+    if (elf_read_firmware(firmware_path.c_str(), &firmware) != 0) {
+        fail("cannot read '" + firmware_path + "'");
+    }
+
+    const char* mcu = firmware.mmcu[0] != '\0' ? firmware.mmcu : "atmega328p";
+
+    sim.avr = avr_make_mcu_by_name(mcu);
+    if (sim.avr == nullptr) {
+        fail(std::string("unknown MCU ") + mcu);
+    }
+
+    avr_init(sim.avr);
+    avr_load_firmware(sim.avr, &firmware);
+
+    sim.avr->frequency = firmware.frequency != 0 ? firmware.frequency : DEFAULT_FREQUENCY;
+    sim.avr->vcc       = 5000;
+    sim.avr->avcc      = 5000;
+    sim.avr->aref      = 5000;
+
+    attach(sim);
+}
+
+// ------------------------------------------------------------------------------
+// Scenario
+
+std::string unescape(const std::string& text) {
+    std::string out;
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] != '\\' || i + 1 >= text.size()) {
+            out.push_back(text[i]);
+            continue;
+        }
+
+        const char c = text[++i];
+        if (c == 'n') {
+            out.push_back('\n');
+        } else if (c == 'x' && i + 2 < text.size()) {
+            out.push_back(static_cast<char>(std::strtoul(text.substr(i + 1, 2).c_str(), nullptr, 16)));
+            i += 2;
+        } else {
+            out.push_back(c);
+        }
+    }
+    return out;
+}
+
+struct Step {
+    std::vector<std::string> args;
+    std::vector<Step> body; // steps of a repeat
+};
+
+std::vector<Step> parse(std::istream& in, const std::string& name, bool nested) {
+    std::vector<Step> steps;
+    std::string line;
+
+    while (std::getline(in, line)) {
+        line = line.substr(0, line.find('#'));
+
+        Step step;
+        std::istringstream words(line);
+        for (std::string word; words >> word;) {
+            step.args.push_back(word);
+        }
+
+        if (step.args.empty()) {
+            continue;
+        }
+
+        if (step.args[0] == "end") {
+            if (!nested) {
+                fail(name + ": 'end' without 'repeat'");
+            }
+            return steps;
+        }
+
+        if (step.args[0] == "repeat") {
+            step.body = parse(in, name, true);
+        }
+
+        steps.push_back(std::move(step));
+    }
+
+    if (nested) {
+        fail(name + ": 'repeat' without 'end'");
+    }
+
+    return steps;
+}
+
+void execute(Simulator& sim, const std::vector<Step>& steps, const std::string& name) {
+    for (const Step& step : steps) {
+        const auto& args = step.args;
+        const auto& cmd  = args[0];
+
+        auto arg = [&](size_t i) -> const std::string& {
+            if (i >= args.size()) {
+                fail(name + ": missing argument of '" + cmd + "'");
+            }
+            return args[i];
+        };
+
+        if (cmd == "wait") {
+            run_ms(sim, std::stoul(arg(1)));
+        } else if (cmd == "request") {
+            sim.samples["request." + arg(1)].push_back(request(sim, unescape(arg(2))));
+        } else if (cmd == "expect") {
+            if (sim.response != unescape(arg(1))) {
+                fail(name + ": expected '" + arg(1) + "', got '" + sim.response + "'");
+            }
+        } else if (cmd == "dht") {
+            sim.dht_tenths = static_cast<int16_t>(std::stoi(arg(1)));
+        } else if (cmd == "adc") {
+            avr_raise_irq(sim.adc[std::stoul(arg(1)) & 7], std::stoul(arg(2)));
+        } else if (cmd == "turn") {
+            const int steps_count = std::stoi(arg(1));
+            for (int i = 0; i < std::abs(steps_count) * 2; ++i) {
+                encoder_transition(sim, steps_count > 0);
+            }
+        } else if (cmd == "click") {
+            set_pin(sim, BUTTON_PIN, false);
+            run_ms(sim, 50);
+            set_pin(sim, BUTTON_PIN, true);
+            run_ms(sim, 50);
+        } else if (cmd == "repeat") {
+            for (unsigned long i = std::stoul(arg(1)); i > 0; --i) {
+                execute(sim, step.body, name);
+            }
+        } else {
+            fail(name + ": unknown step '" + cmd + "'");
+        }
+    }
+}
+
+avr_cycle_count_t percentile(const std::vector<avr_cycle_count_t>& sorted, unsigned percent) {
+    return sorted[((sorted.size() - 1) * percent) / 100];
+}
+
+void report(std::FILE* out, const std::string& scenario, const Simulator& sim) {
+    for (auto [metric, values] : sim.samples) {
+        std::sort(values.begin(), values.end());
+
+        std::fprintf(
+            out,
+            "%s,%s,%zu,%llu,%llu,%llu,%llu,%llu\n",
+            scenario.c_str(),
+            metric.c_str(),
+            values.size(),
+            static_cast<unsigned long long>(values.front()),
+            static_cast<unsigned long long>(percentile(values, 50)),
+            static_cast<unsigned long long>(percentile(values, 90)),
+            static_cast<unsigned long long>(percentile(values, 99)),
+            static_cast<unsigned long long>(values.back())
+        );
+    }
+}
+
+std::string scenario_name(const std::string& path) {
+    const size_t begin = path.find_last_of('/') + 1;
+    const size_t end   = path.find_last_of('.');
+    return path.substr(begin, end > begin ? end - begin : std::string::npos);
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::string firmware;
+    std::string out_path;
+    std::vector<std::string> scenarios;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if ((arg == "--firmware" || arg == "-f") && i + 1 < argc) {
+            firmware = argv[++i];
+        } else if ((arg == "--out" || arg == "-o") && i + 1 < argc) {
+            out_path = argv[++i];
+        } else {
+            scenarios.push_back(arg);
+        }
+    }
+
+    if (firmware.empty() || scenarios.empty()) {
+        std::fprintf(stderr, "usage: %s --firmware <elf> [--out <csv>] <scenario>...\n", argv[0]);
+        return 1;
+    }
+
+    std::FILE* out = out_path.empty() ? stdout : std::fopen(out_path.c_str(), "w");
+    if (out == nullptr) {
+        fail("cannot open '" + out_path + "'");
+    }
+
+    std::fprintf(out, "scenario,metric,count,min,p50,p90,p99,max\n");
+
+    // every scenario starts with a freshly booted firmware
+    for (const auto& path : scenarios) {
+        std::ifstream file(path);
+        if (!file) {
+            fail("cannot open '" + path + "'");
+        }
+
+        const std::string name = scenario_name(path);
+        const auto steps       = parse(file, name, false);
+
+        Simulator sim;
+        load(sim, firmware);
+        execute(sim, steps, name);
+        report(out, name, sim);
+
+        avr_terminate(sim.avr);
+    }
+
+    if (out != stdout) {
+        std::fclose(out);
+    }
+
+    return 0;
+}
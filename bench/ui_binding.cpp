@@ -0,0 +1,154 @@
+#include "bench.h"
+#include "types/index_sequence.h"
+#include "types/sensors.h"
+
+#include <stdint.h>
+
+/*
+ * UI binding: the sensor accesses of the sensors menu through the function pointers of an adapter (the previous
+ * `AppAdapter`) compared with the direct calls of the UI bound to the collection. The file is built twice, with
+ * `BENCH_UI_ADAPTER` set to 1 and 0, so the flash sizes of both firmwares can be compared with `avr-size`.
+ */
+
+#ifndef BENCH_UI_ADAPTER
+#    error BENCH_UI_ADAPTER must be defined
+#endif
+
+using types::index_sequence;
+using types::make_index_sequence;
+using types::SensorBase;
+using types::SensorFlags;
+
+struct DummyData {
+    uint8_t value;
+};
+
+template <uint8_t N> struct DummySensor : SensorBase<DummyData, SensorFlags::HAS_ENABLE | SensorFlags::HAS_WATCH> {
+    static optional_data_t measure() { return optional_data_t::some(DummyData { .value = N }); }
+
+    static void enable() { }
+
+    static void disable() { }
+
+    static optional_watch_t watch(const data_t&) { return optional_watch_t::none(); }
+
+    static void usart_send(const data_t& data) { bench::g_sink = data.value; }
+};
+
+template <typename Seq> struct collection;
+
+template <uint8_t... Is> struct collection<index_sequence<Is...>> {
+    using type = types::SensorsCollection<1, DummySensor<Is>...>;
+};
+
+constexpr uint8_t sensors_count = 16;
+
+using collection_t = typename collection<make_index_sequence<sensors_count>>::type;
+
+namespace {
+
+collection_t s_sensors;
+
+#if BENCH_UI_ADAPTER
+
+struct adapter_t {
+    void* ctx;
+    bool (*is_enabled)(void*, uint8_t);
+    bool (*is_watched)(void*, uint8_t);
+    void (*set_watch)(void*, uint8_t, bool);
+    void (*set_enable)(void*, uint8_t, bool);
+};
+
+bool is_enabled_fn(void* ctx, uint8_t id) { return static_cast<collection_t*>(ctx)->is_enabled(id); }
+
+bool is_watched_fn(void* ctx, uint8_t id) { return static_cast<collection_t*>(ctx)->is_enabled_watch(id); }
+
+void set_watch_fn(void* ctx, uint8_t id, bool enabled) {
+    if (enabled) {
+        static_cast<collection_t*>(ctx)->enable_watch(id);
+    } else {
+        static_cast<collection_t*>(ctx)->disable_watch(id);
+    }
+}
+
+void set_enable_fn(void* ctx, uint8_t id, bool enabled) {
+    if (enabled) {
+        static_cast<collection_t*>(ctx)->enable(id);
+    } else {
+        static_cast<collection_t*>(ctx)->disable(id);
+    }
+}
+
+adapter_t s_adapter = {
+    .ctx        = &s_sensors,
+    .is_enabled = is_enabled_fn,
+    .is_watched = is_watched_fn,
+    .set_watch  = set_watch_fn,
+    .set_enable = set_enable_fn,
+};
+
+// the UI receives the adapter at runtime, so the calls cannot be resolved by the compiler
+adapter_t* volatile s_adapter_ptr = &s_adapter;
+
+void view(uint8_t id) {
+    const adapter_t& adapter = *s_adapter_ptr;
+    bench::g_sink            = adapter.is_enabled(adapter.ctx, id) + adapter.is_watched(adapter.ctx, id);
+}
+
+void toggle_enable(uint8_t id) {
+    const adapter_t& adapter = *s_adapter_ptr;
+    adapter.set_enable(adapter.ctx, id, !adapter.is_enabled(adapter.ctx, id));
+}
+
+void toggle_watch(uint8_t id) {
+    const adapter_t& adapter = *s_adapter_ptr;
+    adapter.set_watch(adapter.ctx, id, !adapter.is_watched(adapter.ctx, id));
+}
+
+constexpr const char* view_name   = "adapter.view";
+constexpr const char* enable_name = "adapter.toggle_enable";
+constexpr const char* watch_name  = "adapter.toggle_watch";
+
+#else
+
+void view(uint8_t id) { bench::g_sink = s_sensors.is_enabled(id) + s_sensors.is_enabled_watch(id); }
+
+void toggle_enable(uint8_t id) {
+    if (s_sensors.is_enabled(id)) {
+        s_sensors.disable(id);
+    } else {
+        s_sensors.enable(id);
+    }
+}
+
+void toggle_watch(uint8_t id) {
+    if (s_sensors.is_enabled_watch(id)) {
+        s_sensors.disable_watch(id);
+    } else {
+        s_sensors.enable_watch(id);
+    }
+}
+
+constexpr const char* view_name   = "direct.view";
+constexpr const char* enable_name = "direct.toggle_enable";
+constexpr const char* watch_name  = "direct.toggle_watch";
+
+#endif
+
+}
+
+int main() {
+    bench::init();
+
+    s_sensors.init();
+
+    volatile uint8_t id = sensors_count - 1;
+
+    bench::report(view_name, sensors_count, bench::measure([&] { view(id); }));
+    bench::report(enable_name, sensors_count, bench::measure([&] { toggle_enable(id); }));
+    bench::report(watch_name, sensors_count, bench::measure([&] { toggle_watch(id); }));
+
+    bench::done();
+
+    while (true) { }
+}
@@ -4,6 +4,7 @@ find_program(AVR_OBJCOPY avr-objcopy REQUIRED)
 find_program(AVR_SIZE_TOOL avr-size REQUIRED)
 find_program(AVR_OBJDUMP avr-objdump REQUIRED)
 find_program(AVR_STRIP avr-strip REQUIRED)
+find_program(AVR_NM avr-nm REQUIRED)
 
 # ------------------------------------------------------------------------------
 # Target
@@ -0,0 +1,21 @@
+#ifndef HOST_AVR_EEPROM_H
+#define HOST_AVR_EEPROM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Host replacement of the avr-libc EEPROM access, the EEPROM variables are ordinary variables.
+ */
+#define EEMEM
+
+inline uint8_t eeprom_read_byte(const uint8_t* ptr) { return *ptr; }
+
+inline void eeprom_update_byte(uint8_t* ptr, uint8_t value) { *ptr = value; }
+
+inline void eeprom_read_block(void* dst, const void* src, size_t size) { memcpy(dst, src, size); }
+
+inline void eeprom_update_block(const void* src, void* dst, size_t size) { memcpy(dst, src, size); }
+
+#endif
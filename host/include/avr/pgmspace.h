@@ -0,0 +1,14 @@
+#ifndef HOST_AVR_PGMSPACE_H
+#define HOST_AVR_PGMSPACE_H
+
+#include <stdint.h>
+
+/*
+ * Host replacement of the avr-libc program memory, the host has one address space.
+ */
+#define PROGMEM
+
+#define pgm_read_byte(ptr) (*reinterpret_cast<const uint8_t*>(ptr))
+#define pgm_read_word(ptr) (*reinterpret_cast<const uint16_t*>(ptr))
+
+#endif
@@ -0,0 +1,192 @@
+#ifndef HOST_MICROSTD_MCU_IO_H
+#define HOST_MICROSTD_MCU_IO_H
+
+#include <microstd/mcu/reg.h>
+
+#include <stdint.h>
+
+/*
+ * Host replacement of the microstd I/O registers. Every register is a byte of a mock data space at the address of the
+ * ATmega328P register. The hooks model a peripheral, e.g. a test feeds the received bytes through the `UDR0` read
+ * hook.
+ *
+ * The interrupt handlers are ordinary functions, a test raises an interrupt by calling its handler.
+ */
+#define SIGNAL(vector) extern "C" void vector()
+
+#define INT_INT0         host_isr_int0
+#define INT_INT1         host_isr_int1
+#define INT_PCINT2       host_isr_pcint2
+#define INT_TIMER1_COMPA host_isr_timer1_compa
+#define INT_TWI          host_isr_twi
+
+namespace microstd::mcu {
+
+inline void enable_interrupts() { }
+
+inline void disable_interrupts() { }
+
+namespace io {
+
+    namespace mock {
+
+        /**
+         * @brief The registers and the I/O memory (the first 256 bytes of the data space).
+         */
+        inline uint8_t data_space[256] = {};
+
+    }
+
+    template <uint8_t Address> struct mock_register {
+        using register_t = mock_register;
+
+        static constexpr uint8_t address = Address;
+
+        /**
+         * @brief Returns the read value instead of the stored one, e.g. the next received byte.
+         */
+        static inline uint8_t (*on_read)() = nullptr;
+
+        /**
+         * @brief Called after every write with the written value.
+         */
+        static inline void (*on_write)(uint8_t) = nullptr;
+
+        static uint8_t read() { return (on_read != nullptr) ? on_read() : mock::data_space[Address]; }
+
+        static void write(uint8_t value) {
+            mock::data_space[Address] = value;
+
+            if (on_write != nullptr) {
+                on_write(value);
+            }
+        }
+
+        template <typename... Bits> static void write() { write((Bits::bit | ... | 0)); }
+
+        template <typename... Bits> static void set_bits() {
+            write(static_cast<uint8_t>(mock::data_space[Address] | (Bits::bit | ... | 0)));
+        }
+
+        template <typename... Bits> static void unset_bits() {
+            write(static_cast<uint8_t>(mock::data_space[Address] & ~(Bits::bit | ... | 0)));
+        }
+    };
+
+    template <typename Register, uint8_t Index> struct mock_bit {
+        using register_t = Register;
+
+        static constexpr uint8_t bit = 1 << Index;
+
+        static void set() { Register::template set_bits<mock_bit>(); }
+
+        static void unset() { Register::template unset_bits<mock_bit>(); }
+
+        static bool is_set() { return (Register::read() & bit) != 0; }
+    };
+
+    template <uint8_t Address, typename T = uint8_t> struct mock_timer {
+        static T get_value() {
+            if constexpr (sizeof(T) == 2) {
+                return static_cast<T>(mock::data_space[Address] | (mock::data_space[Address + 1] << 8));
+            } else {
+                return mock::data_space[Address];
+            }
+        }
+    };
+
+#define HOST_MOCK_PORT(NAME, PIN_ADDRESS)                \
+    using PIN##NAME  = mock_register<PIN_ADDRESS>;       \
+    using DDR##NAME  = mock_register<(PIN_ADDRESS) + 1>; \
+    using PORT##NAME = mock_register<(PIN_ADDRESS) + 2>; \
+    using PIN##NAME##0 = mock_bit<PIN##NAME, 0>;         \
+    using PIN##NAME##1 = mock_bit<PIN##NAME, 1>;         \
+    using PIN##NAME##2 = mock_bit<PIN##NAME, 2>;         \
+    using PIN##NAME##3 = mock_bit<PIN##NAME, 3>;         \
+    using PIN##NAME##4 = mock_bit<PIN##NAME, 4>;         \
+    using PIN##NAME##5 = mock_bit<PIN##NAME, 5>;         \
+    using PIN##NAME##6 = mock_bit<PIN##NAME, 6>;         \
+    using PIN##NAME##7 = mock_bit<PIN##NAME, 7>;         \
+    using DDR##NAME##0 = mock_bit<DDR##NAME, 0>;         \
+    using DDR##NAME##1 = mock_bit<DDR##NAME, 1>;         \
+    using DDR##NAME##2 = mock_bit<DDR##NAME, 2>;         \
+    using DDR##NAME##3 = mock_bit<DDR##NAME, 3>;         \
+    using DDR##NAME##4 = mock_bit<DDR##NAME, 4>;         \
+    using DDR##NAME##5 = mock_bit<DDR##NAME, 5>;         \
+    using DDR##NAME##6 = mock_bit<DDR##NAME, 6>;         \
+    using DDR##NAME##7 = mock_bit<DDR##NAME, 7>;         \
+    using PORT##NAME##0 = mock_bit<PORT##NAME, 0>;       \
+    using PORT##NAME##1 = mock_bit<PORT##NAME, 1>;       \
+    using PORT##NAME##2 = mock_bit<PORT##NAME, 2>;       \
+    using PORT##NAME##3 = mock_bit<PORT##NAME, 3>;       \
+    using PORT##NAME##4 = mock_bit<PORT##NAME, 4>;       \
+    using PORT##NAME##5 = mock_bit<PORT##NAME, 5>;       \
+    using PORT##NAME##6 = mock_bit<PORT##NAME, 6>;       \
+    using PORT##NAME##7 = mock_bit<PORT##NAME, 7>;
+
+    HOST_MOCK_PORT(B, 0x23)
+    HOST_MOCK_PORT(C, 0x26)
+    HOST_MOCK_PORT(D, 0x29)
+
+#undef HOST_MOCK_PORT
+
+    // USART0
+    using UCSR0A = mock_register<0xC0>;
+    using UCSR0B = mock_register<0xC1>;
+    using UCSR0C = mock_register<0xC2>;
+    using UBRR0L = mock_register<0xC4>;
+    using UBRR0H = mock_register<0xC5>;
+    using UDR0   = mock_register<0xC6>;
+
+    using RXC0  = mock_bit<UCSR0A, 7>;
+    using TXC0  = mock_bit<UCSR0A, 6>;
+    using UDRE0 = mock_bit<UCSR0A, 5>;
+
+    using RXCIE0 = mock_bit<UCSR0B, 7>;
+    using TXCIE0 = mock_bit<UCSR0B, 6>;
+    using UDRIE0 = mock_bit<UCSR0B, 5>;
+    using RXEN0  = mock_bit<UCSR0B, 4>;
+    using TXEN0  = mock_bit<UCSR0B, 3>;
+
+    using UCSZ01 = mock_bit<UCSR0C, 2>;
+    using UCSZ00 = mock_bit<UCSR0C, 1>;
+
+    // external interrupts
+    using EIFR  = mock_register<0x3C>;
+    using EIMSK = mock_register<0x3D>;
+    using EICRA = mock_register<0x69>;
+
+    using INTF0 = mock_bit<EIFR, 0>;
+    using INTF1 = mock_bit<EIFR, 1>;
+    using INT0  = mock_bit<EIMSK, 0>;
+    using INT1  = mock_bit<EIMSK, 1>;
+    using ISC00 = mock_bit<EICRA, 0>;
+    using ISC01 = mock_bit<EICRA, 1>;
+    using ISC10 = mock_bit<EICRA, 2>;
+    using ISC11 = mock_bit<EICRA, 3>;
+
+    // pin change interrupt of the port D
+    using PCICR  = mock_register<0x68>;
+    using PCMSK2 = mock_register<0x6D>;
+
+    using PCIE2 = mock_bit<PCICR, 2>;
+
+    using PCINT16 = mock_bit<PCMSK2, 0>;
+    using PCINT17 = mock_bit<PCMSK2, 1>;
+    using PCINT18 = mock_bit<PCMSK2, 2>;
+    using PCINT19 = mock_bit<PCMSK2, 3>;
+    using PCINT20 = mock_bit<PCMSK2, 4>;
+    using PCINT21 = mock_bit<PCMSK2, 5>;
+    using PCINT22 = mock_bit<PCMSK2, 6>;
+    using PCINT23 = mock_bit<PCMSK2, 7>;
+
+    // timers, the counter registers (TCNTx)
+    using Timer0 = mock_timer<0x46>;
+    using Timer1 = mock_timer<0x84, uint16_t>;
+    using Timer2 = mock_timer<0xB2>;
+
+}
+
+}
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef HOST_MICROSTD_MCU_REG_H
+#define HOST_MICROSTD_MCU_REG_H
+
+#include <stdint.h>
+
+/*
+ * Host replacement of the microstd register concepts, the registers are the mock registers of `microstd/mcu/io.h`.
+ */
+namespace microstd::mcu {
+
+template <typename T>
+concept is_readable_register = requires { T::read(); };
+
+template <typename T>
+concept is_normal_register = is_readable_register<T> && requires(uint8_t value) { T::write(value); };
+
+template <typename T>
+concept is_any_register_bit = requires {
+    typename T::register_t;
+    T::bit;
+};
+
+}
+
+#endif
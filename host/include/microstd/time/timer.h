@@ -0,0 +1,49 @@
+#ifndef HOST_MICROSTD_TIME_TIMER_H
+#define HOST_MICROSTD_TIME_TIMER_H
+
+#include <microstd/mcu/io.h>
+#include <microstd/time/unit.h>
+
+#include <stdint.h>
+
+/*
+ * Host replacement of the microstd timers. The host has no time base, so every started timer has already expired and
+ * the timed waits (e.g. `com::usart::try_read_timeout`) return at once.
+ */
+namespace microstd::time {
+
+namespace avr {
+
+    template <typename T>
+    concept is_avr_timer = requires { T::get_value(); };
+
+    struct ClockSource1 { };
+
+    struct ClockSource8 { };
+
+    struct ClockSource64 { };
+
+    struct ClockSource256 { };
+
+    struct ClockSource1024 { };
+
+    template <typename T>
+    concept clock_source = requires { sizeof(T); };
+
+}
+
+template <avr::is_avr_timer Timer> struct CountTimer {
+    static void init() { }
+
+    template <avr::clock_source Source, time_unit Unit> static void start() { }
+
+    static void stop() { }
+
+    static void enable_interrupt() { }
+
+    static bool flag() { return true; }
+};
+
+}
+
+#endif
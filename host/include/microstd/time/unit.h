@@ -0,0 +1,24 @@
+#ifndef HOST_MICROSTD_TIME_UNIT_H
+#define HOST_MICROSTD_TIME_UNIT_H
+
+#include <stdint.h>
+
+/*
+ * Host replacement of the microstd time units.
+ */
+namespace microstd::time {
+
+template <uint32_t N> struct Microseconds {
+    static constexpr uint32_t value = N;
+};
+
+template <uint32_t N> struct Milliseconds {
+    static constexpr uint32_t value = N;
+};
+
+template <typename T>
+concept time_unit = requires { T::value; };
+
+}
+
+#endif
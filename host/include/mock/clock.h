@@ -0,0 +1,26 @@
+#ifndef HOST_MOCK_CLOCK_H
+#define HOST_MOCK_CLOCK_H
+
+#include <microstd/mcu/io.h>
+
+#include <stdint.h>
+
+/*
+ * The millisecond clock of the host build, the Timer1 compare interrupt (src/app.cpp) is raised by the test.
+ */
+SIGNAL(INT_TIMER1_COMPA);
+
+namespace mock::clock {
+
+/**
+ * @brief Advances `g_millis` and `g_uptime` by the milliseconds.
+ */
+inline void advance(uint32_t ms) {
+    for (uint32_t i = 0; i < ms; ++i) {
+        INT_TIMER1_COMPA();
+    }
+}
+
+}
+
+#endif
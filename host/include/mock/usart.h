@@ -0,0 +1,78 @@
+#ifndef HOST_MOCK_USART_H
+#define HOST_MOCK_USART_H
+
+#include <microstd/mcu/io.h>
+
+#include <deque>
+#include <stdint.h>
+#include <string>
+#include <string_view>
+
+/*
+ * USART peripheral of the host build: the bytes fed by a test are received by the firmware and the bytes written to
+ * `UDR0` are collected.
+ */
+namespace mock::usart {
+
+/**
+ * @brief The bytes waiting to be received by the firmware.
+ */
+inline std::deque<uint8_t> g_received;
+
+/**
+ * @brief The bytes sent by the firmware since the last `take_sent`.
+ */
+inline std::string g_sent;
+
+/**
+ * @brief Connects the peripheral to the USART registers and clears both directions. The transmitter is always ready.
+ */
+inline void init() {
+    using namespace microstd::mcu::io;
+
+    g_received.clear();
+    g_sent.clear();
+
+    UCSR0A::on_read = [] {
+        uint8_t value = UDRE0::bit;
+        if (!g_received.empty()) {
+            value |= RXC0::bit;
+        }
+
+        return value;
+    };
+
+    UDR0::on_read = [] {
+        if (g_received.empty()) {
+            return uint8_t { 0 };
+        }
+
+        const uint8_t byte = g_received.front();
+        g_received.pop_front();
+        return byte;
+    };
+
+    UDR0::on_write = [](uint8_t byte) { g_sent.push_back(static_cast<char>(byte)); };
+}
+
+/**
+ * @brief Queues the bytes received by the firmware.
+ */
+inline void feed(std::string_view bytes) {
+    for (const char c : bytes) {
+        g_received.push_back(static_cast<uint8_t>(c));
+    }
+}
+
+/**
+ * @brief Takes the bytes sent by the firmware.
+ */
+inline std::string take_sent() {
+    std::string sent;
+    sent.swap(g_sent);
+    return sent;
+}
+
+}
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef HOST_UTIL_ATOMIC_H
+#define HOST_UTIL_ATOMIC_H
+
+/*
+ * Host replacement of the avr-libc atomic blocks, the host build has no interrupts, so the block runs once.
+ */
+#define ATOMIC_RESTORESTATE
+#define ATOMIC_FORCEON
+
+#define ATOMIC_BLOCK(type) for (bool host_atomic_done = false; !host_atomic_done; host_atomic_done = true)
+
+#endif
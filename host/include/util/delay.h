@@ -0,0 +1,21 @@
+#ifndef HOST_UTIL_DELAY_H
+#define HOST_UTIL_DELAY_H
+
+/*
+ * Host replacement of the avr-libc busy waits, the host does not wait. The waited time is summed, so a simulated
+ * peripheral can measure the pulses of a bit-banged protocol (e.g. the 1-Wire time slots).
+ */
+namespace mock::delay {
+
+/**
+ * @brief The waited microseconds since the start.
+ */
+inline double g_elapsed_us = 0;
+
+}
+
+inline void _delay_ms(double ms) { mock::delay::g_elapsed_us += ms * 1000; }
+
+inline void _delay_us(double us) { mock::delay::g_elapsed_us += us; }
+
+#endif
@@ -7,14 +7,16 @@
 #include <microstd/types/array.h>
 #include <microstd/types/tuple.h>
 
+#include "clock.h"
 #include "com/usart.h"
+#include "trace.h"
+#include "types/events.h"
 #include "types/sensors.h"
 #include "ui.h"
+#include "vm/vm.h"
 #include <stdint.h>
 #include <util/delay.h>
 
-extern uint32_t g_seconds;
-
 /*
  * @brief App
  *
@@ -22,7 +24,7 @@ extern uint32_t g_seconds;
  * @tparam Sensors Variadic template parameter representing the sensors used in the application.
  *
  */
-template <bool EnableUI, uint16_t CacheSize = 1, types::sensor... Sensors> class App {
+template <bool EnableUI, uint16_t CacheSize = 1, types::sensor_entry... Sensors> class App {
 private:
     /**
      * @brief Enumeration representing various states of the application.
@@ -42,9 +44,25 @@ template <bool EnableUI, uint16_t CacheSize = 1, types::sensor... Sensors> class
 
         SENSOR_READ     = 'r',
         SENSOR_READ_ALL = 'R',
+        SENSOR_READ_RLE = 'z',
 
         EXPORT_CONFIG = 'E',
         IMPORT_CONFIG = 'I',
+
+        PROGRAM_UPLOAD  = 'P',
+        PROGRAM_PERSIST = 'p',
+        PROGRAM_STATUS  = 'v',
+
+        EVENTS_DRAIN = 'q',
+        EVENTS_PUSH  = 'Q',
+
+        SENSOR_META = 'm',
+
+        SET_CALIBRATION = 'k',
+
+        SENSOR_HEALTH = 'h',
+
+        UI_REDRAW = 'u',
     };
 
     enum class ErrorCode : uint8_t {
@@ -55,17 +73,49 @@ template <bool EnableUI, uint16_t CacheSize = 1, types::sensor... Sensors> class
         INVALID_CONFIG         = 4,
         CONFIG_CHECKSUM_FAILED = 5,
         UNKNOWN_CMD            = 6,
+        INVALID_PROGRAM        = 7,
+        INVALID_PUSH_MODE      = 8,
+        INVALID_CALIBRATION    = 9,
     };
 
+    /**
+     * @brief Responses of the error codes indexed by the code, stored in the program memory (PROGMEM).
+     */
+    static constexpr char ERROR_TEXTS[][3] PROGMEM = {
+        "E0", "E1", "E2", "E3", "E4", "E5", "E6", "E7", "E8", "E9",
+    };
+    static_assert(
+        sizeof(ERROR_TEXTS) / sizeof(ERROR_TEXTS[0]) == static_cast<uint8_t>(ErrorCode::INVALID_CALIBRATION) + 1
+    );
+
     using sensors_t   = types::SensorsCollection<CacheSize, Sensors...>;
     using timer_t     = microstd::time::CountTimer<microstd::mcu::io::Timer1>;
-    using timer_delay = microstd::time::Milliseconds<1000>;
+    using timer_delay = microstd::time::Milliseconds<1>;
+
+    using ui_t = ui_type<EnableUI, sensors_t>;
 
-    using ui_t = ui_type<EnableUI>;
+    static constexpr uint8_t event_queue_size = 8;
+    using event_queue_t                       = types::EventQueue<event_queue_size>;
+
+    /**
+     * @brief The first byte of an unsolicited event frame.
+     */
+    static constexpr uint8_t event_push_marker = '!';
 
     using usart_timer_delay = microstd::time::Milliseconds<10>;
 
-    static constexpr uint8_t config_size = (sensors_t::bitarray_size() * 2) + (sizeof(uint32_t) / sizeof(uint8_t));
+    /**
+     * @brief The size of a calibration record: c2, c1, offset and divisor (all 16-bit big-endian).
+     */
+    static constexpr uint8_t calibration_size = 4 * sizeof(uint16_t);
+
+    /**
+     * @brief The size of the config without the checksum.
+     */
+    static constexpr uint16_t config_size = (sensors_t::bitarray_size() * 2) + (sizeof(uint32_t) / sizeof(uint8_t))
+        + (sensors_t::calibrations_count * calibration_size);
+
+    static_assert(config_size < 0xFF, "The config is too large");
 
 public:
     /**
@@ -75,6 +125,24 @@ template <bool EnableUI, uint16_t CacheSize = 1, types::sensor... Sensors> class
      */
     void run(uint16_t baudrate);
 
+    /**
+     * @brief Initializes the USART, the UI, the sensors and the clock. Called by `run`.
+     *
+     * @param baudrate The baud rate for USART communication.
+     */
+    void begin(uint16_t baudrate);
+
+    /**
+     * @brief Runs one iteration of the main loop: the measurement, the UI update and one step of the command state
+     * machine.
+     */
+    void step();
+
+    /**
+     * @brief Checks whether no command is in progress.
+     */
+    [[nodiscard]] bool idle() const { return m_state == State::NORMAL; }
+
 private:
     State state_normal();
     State state_enable_sensor();
@@ -85,40 +153,37 @@ template <bool EnableUI, uint16_t CacheSize = 1, types::sensor... Sensors> class
     State state_list_sensors_state();
     State state_sensor_read();
     State state_sensor_read_all();
+    State state_sensor_read_rle();
     State state_export_config();
     State state_import_config();
+    State state_program_upload();
+    State state_program_persist();
+    State state_program_status();
+    State state_events_drain();
+    State state_events_push();
+    State state_sensor_meta();
+    State state_set_calibration();
+    State state_sensor_health();
+    State state_ui_redraw();
     void try_measure();
+    void refresh_lazy(uint8_t id);
+    void push_events();
+    static void send_event(const types::event_t& event);
 
-    static void set_interval_fn(void* ctx, uint32_t interval) { static_cast<App*>(ctx)->m_delay = interval; }
-
-    static bool is_enabled_fn(void* ctx, uint8_t id) { return static_cast<App*>(ctx)->m_sensors.is_enabled(id); }
-
-    static bool is_watched_fn(void* ctx, uint8_t id) { return static_cast<App*>(ctx)->m_sensors.is_enabled_watch(id); }
-
-    static void set_watch_fn(void* ctx, uint8_t id, bool enabled) {
-        if (enabled) {
-            static_cast<App*>(ctx)->m_sensors.enable_watch(id);
-        } else {
-            static_cast<App*>(ctx)->m_sensors.disable_watch(id);
-        }
+    static void send_u16(uint16_t value) {
+        com::usart::send(static_cast<uint8_t>(value >> 8));
+        com::usart::send(static_cast<uint8_t>(value));
     }
 
-    static void set_enable_fn(void* ctx, uint8_t id, bool enabled) {
-        if (enabled) {
-            static_cast<App*>(ctx)->m_sensors.enable(id);
-        } else {
-            static_cast<App*>(ctx)->m_sensors.disable(id);
-        }
+    static bool vm_load_fn(void* ctx, uint8_t sensor, uint8_t age, uint8_t offset, uint8_t size, uint8_t* out) {
+        return static_cast<App*>(ctx)->m_sensors.read_raw(sensor, age, offset, size, out);
     }
 
-    AppAdapter get_adapter() {
-        return AppAdapter {
-            .ctx          = this,
-            .set_interval = set_interval_fn,
-            .is_enabled   = is_enabled_fn,
-            .is_watched   = is_watched_fn,
-            .set_watch    = set_watch_fn,
-            .set_enable   = set_enable_fn,
+    vm::VmAdapter get_vm_adapter() {
+        return vm::VmAdapter {
+            .ctx           = this,
+            .load          = vm_load_fn,
+            .sensors_count = sensors_t::sensors_count,
         };
     }
 
@@ -157,11 +222,22 @@ template <bool EnableUI, uint16_t CacheSize = 1, types::sensor... Sensors> class
      * @return true if reading was successful, false otherwise.
      */
     template <uint8_t Size> static bool read_buff(microstd::types::array_t<uint8_t, Size>& out) {
+        return read_bytes(out.data(), Size);
+    }
+
+    /**
+     * @brief Reads a runtime number of bytes from the USART.
+     *
+     * @param out Pointer to the output buffer.
+     * @param size The number of bytes to read.
+     * @return true if reading was successful, false otherwise.
+     */
+    static bool read_bytes(uint8_t* out, uint8_t size) {
         using com::usart::try_read_timeout;
         using namespace microstd::mcu::io;
         using microstd::time::avr::ClockSource1024;
 
-        for (uint8_t i = 0; i < Size; ++i) {
+        for (uint8_t i = 0; i < size; ++i) {
             if (!try_read_timeout<Timer0, ClockSource1024, usart_timer_delay>(out[i])) {
                 return false;
             }
@@ -170,6 +246,22 @@ template <bool EnableUI, uint16_t CacheSize = 1, types::sensor... Sensors> class
         return true;
     }
 
+    /**
+     * @brief Reads a calibration record.
+     *
+     * @param buff Pointer to the record (`calibration_size` bytes).
+     * @param out Reference to the output calibration.
+     * @return false if the calibration is invalid.
+     */
+    static bool parse_calibration(const uint8_t* buff, types::calibration_t& out) {
+        const auto read_u16 = [buff](uint8_t i) { return static_cast<uint16_t>((buff[i] << 8) | buff[i + 1]); };
+
+        return types::calibration_t::make(
+            static_cast<int16_t>(read_u16(0)), static_cast<int16_t>(read_u16(2)), static_cast<int16_t>(read_u16(4)),
+            read_u16(6), out
+        );
+    }
+
     /**
      * @brief Executes a callback function for a specific sensor.
      *
@@ -182,128 +274,228 @@ template <bool EnableUI, uint16_t CacheSize = 1, types::sensor... Sensors> class
             callback(id);
             send_ok();
         } else {
-            send_err<ErrorCode::INVALID_SENSOR>();
+            send_err(ErrorCode::INVALID_SENSOR);
         }
     }
 
-    template <ErrorCode Code> void send_err() {
-        switch (static_cast<uint8_t>(Code)) {
-        case 0:
-            com::usart::send("E0");
-            break;
-        case 1:
-            com::usart::send("E1");
-            break;
-        case 2:
-            com::usart::send("E2");
-            break;
-        case 3:
-            com::usart::send("E3");
-            break;
-        case 4:
-            com::usart::send("E4");
-            break;
-        case 5:
-            com::usart::send("E5");
-            break;
-        case 6:
-            com::usart::send("E6");
-            break;
-        case 7:
-            com::usart::send("E7");
-            break;
-        case 8:
-            com::usart::send("E8");
-            break;
-        case 9:
-            com::usart::send("E9");
-        }
-    }
+    void send_err(ErrorCode code) { com::usart::send(types::flash_string(ERROR_TEXTS[static_cast<uint8_t>(code)])); }
 
-    void send_ok() { com::usart::send("OK"); }
+    void send_ok() { com::usart::send(FSTR("OK")); }
 
 private:
     sensors_t m_sensors;
-    uint32_t m_delay = 5;
+    uint32_t m_delay        = 5;
+    uint32_t m_last_measure = 0;
     ui_t m_ui;
+    vm::Machine m_vm;
+    bool m_vm_triggered = false;
+
+    event_queue_t m_events;
+    bool m_push_events = false;
+
+    State m_state = State::NORMAL;
 };
 
-#define IMPL_STATE(NAME)                                             \
-    template <bool UI, uint16_t CacheSize, types::sensor... Sensors> \
+#define IMPL_STATE(NAME)                                                   \
+    template <bool UI, uint16_t CacheSize, types::sensor_entry... Sensors> \
     inline App<UI, CacheSize, Sensors...>::State App<UI, CacheSize, Sensors...>::state_##NAME()
 
-template <bool UI, uint16_t CacheSize, types::sensor... Sensors>
+template <bool UI, uint16_t CacheSize, types::sensor_entry... Sensors>
 inline void App<UI, CacheSize, Sensors...>::run(uint16_t baudrate) {
+    begin(baudrate);
+
+    while (true) {
+        step();
+    }
+}
+
+template <bool UI, uint16_t CacheSize, types::sensor_entry... Sensors>
+inline void App<UI, CacheSize, Sensors...>::begin(uint16_t baudrate) {
     using namespace com;
     usart::init(baudrate);
 
     if constexpr (UI) {
-        m_ui.init(m_delay, get_adapter(), m_sensors.size());
+        m_ui.init(m_sensors, m_delay);
     }
 
     m_sensors.init();
+    m_vm.init(get_vm_adapter());
 
     timer_t::init();
-    timer_t::start<microstd::time::avr::ClockSource1024, timer_delay>();
+    timer_t::start<microstd::time::avr::ClockSource64, timer_delay>();
 
     timer_t::enable_interrupt();
 
     microstd::mcu::enable_interrupts();
+}
 
-    State state = State::NORMAL;
-    while (true) {
-        try_measure();
+template <bool UI, uint16_t CacheSize, types::sensor_entry... Sensors>
+inline void App<UI, CacheSize, Sensors...>::step() {
+    try_measure();
 
-        if constexpr (UI) {
-            m_ui.update();
-        }
+    if constexpr (UI) {
+        trace::begin(trace::Span::UI_UPDATE);
+        m_ui.update();
+        trace::end(trace::Span::UI_UPDATE);
+    }
 
-        switch (state) {
-        case State::NORMAL:
-            state = state_normal();
-            break;
-        case State::ENABLE_SENSOR:
-            state = state_enable_sensor();
-            break;
-        case State::DISABLE_SENSOR:
-            state = state_disable_sensor();
-            break;
-        case State::SET_INTERVAL:
-            state = state_set_interval();
-            break;
-        case State::SET_SENSOR_WATCH:
-            state = state_set_sensor_watch();
-            break;
-        case State::CLEAR_SENSOR_WATCH:
-            state = state_clear_sensor_watch();
-            break;
-        case State::LIST_SENSORS_STATE:
-            state = state_list_sensors_state();
-            break;
-        case State::SENSOR_READ:
-            state = state_sensor_read();
-            break;
-        case State::SENSOR_READ_ALL:
-            state = state_sensor_read_all();
-            break;
-        case State::EXPORT_CONFIG:
-            state = state_export_config();
-            break;
-        case State::IMPORT_CONFIG:
-            state = state_import_config();
-            break;
-        }
+    const State previous = m_state;
+
+    switch (m_state) {
+    case State::NORMAL:
+        m_state = state_normal();
+        break;
+    case State::ENABLE_SENSOR:
+        m_state = state_enable_sensor();
+        break;
+    case State::DISABLE_SENSOR:
+        m_state = state_disable_sensor();
+        break;
+    case State::SET_INTERVAL:
+        m_state = state_set_interval();
+        break;
+    case State::SET_SENSOR_WATCH:
+        m_state = state_set_sensor_watch();
+        break;
+    case State::CLEAR_SENSOR_WATCH:
+        m_state = state_clear_sensor_watch();
+        break;
+    case State::LIST_SENSORS_STATE:
+        m_state = state_list_sensors_state();
+        break;
+    case State::SENSOR_READ:
+        m_state = state_sensor_read();
+        break;
+    case State::SENSOR_READ_ALL:
+        m_state = state_sensor_read_all();
+        break;
+    case State::SENSOR_READ_RLE:
+        m_state = state_sensor_read_rle();
+        break;
+    case State::EXPORT_CONFIG:
+        m_state = state_export_config();
+        break;
+    case State::IMPORT_CONFIG:
+        m_state = state_import_config();
+        break;
+    case State::PROGRAM_UPLOAD:
+        m_state = state_program_upload();
+        break;
+    case State::PROGRAM_PERSIST:
+        m_state = state_program_persist();
+        break;
+    case State::PROGRAM_STATUS:
+        m_state = state_program_status();
+        break;
+    case State::EVENTS_DRAIN:
+        m_state = state_events_drain();
+        break;
+    case State::EVENTS_PUSH:
+        m_state = state_events_push();
+        break;
+    case State::SENSOR_META:
+        m_state = state_sensor_meta();
+        break;
+    case State::SET_CALIBRATION:
+        m_state = state_set_calibration();
+        break;
+    case State::SENSOR_HEALTH:
+        m_state = state_sensor_health();
+        break;
+    case State::UI_REDRAW:
+        m_state = state_ui_redraw();
+        break;
+    }
+
+    // the command starts when its byte is read and ends when the state returns to normal
+    if (previous == State::NORMAL && m_state != State::NORMAL) {
+        trace::begin(trace::Span::COMMAND);
+    } else if (previous != State::NORMAL && m_state == State::NORMAL) {
+        trace::end(trace::Span::COMMAND);
     }
 }
 
-template <bool UI, uint16_t CacheSize, types::sensor... Sensors>
+template <bool UI, uint16_t CacheSize, types::sensor_entry... Sensors>
 inline void App<UI, CacheSize, Sensors...>::try_measure() {
+    uint32_t now;
+    uint32_t timestamp;
+
     microstd::mcu::disable_interrupts();
-    if (g_seconds >= m_delay) {
-        m_sensors.measure_all();
-        g_seconds = 0;
+    now       = g_millis;
+    timestamp = g_uptime;
+    microstd::mcu::enable_interrupts();
+
+    const uint32_t interval = m_delay * 1000;
+    const uint32_t elapsed  = now - m_last_measure;
+
+    if (elapsed < interval) {
+        m_sensors.power_up(interval - elapsed);
+        return;
+    }
+
+    m_last_measure = now;
+
+    trace::begin(trace::Span::MEASURE);
+    m_sensors.template measure_all<timer_clock_t>(m_events, timestamp);
+    trace::end(trace::Span::MEASURE);
+
+    m_sensors.power_down();
+
+    if constexpr (UI) {
+        m_ui.samples_updated();
+    }
+
+    m_vm.run();
+
+    // the program raises an event when its result becomes non-zero
+    const bool triggered = m_vm.status() == vm::Status::OK && m_vm.result() != 0;
+    if (triggered && !m_vm_triggered) {
+        m_events.push(types::event_t {
+            .sensor    = types::PROGRAM_EVENT_SENSOR,
+            .rule      = 0,
+            .timestamp = timestamp,
+            .value     = m_vm.result(),
+        });
     }
+    m_vm_triggered = triggered;
+
+    if (m_push_events) {
+        push_events();
+    }
+}
+
+template <bool UI, uint16_t CacheSize, types::sensor_entry... Sensors>
+inline void App<UI, CacheSize, Sensors...>::refresh_lazy(uint8_t id) {
+    uint32_t timestamp;
+
+    microstd::mcu::disable_interrupts();
+    timestamp = g_uptime;
     microstd::mcu::enable_interrupts();
+
+    m_sensors.refresh(id, m_events, timestamp);
+}
+
+template <bool UI, uint16_t CacheSize, types::sensor_entry... Sensors>
+inline void App<UI, CacheSize, Sensors...>::push_events() {
+    types::event_t event;
+    while (m_events.pop(event)) {
+        com::usart::send(event_push_marker);
+        send_event(event);
+    }
+}
+
+template <bool UI, uint16_t CacheSize, types::sensor_entry... Sensors>
+inline void App<UI, CacheSize, Sensors...>::send_event(const types::event_t& event) {
+    com::usart::send(event.sensor);
+    com::usart::send(event.rule);
+
+    for (uint8_t i = sizeof(uint32_t); i > 0; --i) {
+        com::usart::send(static_cast<uint8_t>(event.timestamp >> (8 * (i - 1))));
+    }
+
+    const auto value = static_cast<uint16_t>(event.value);
+    com::usart::send(static_cast<uint8_t>(value >> 8));
+    com::usart::send(static_cast<uint8_t>(value));
 }
 
 IMPL_STATE(normal) {
@@ -322,12 +514,22 @@ IMPL_STATE(normal) {
     case State::LIST_SENSORS_STATE:
     case State::SENSOR_READ:
     case State::SENSOR_READ_ALL:
+    case State::SENSOR_READ_RLE:
     case State::IMPORT_CONFIG:
     case State::EXPORT_CONFIG:
+    case State::PROGRAM_UPLOAD:
+    case State::PROGRAM_PERSIST:
+    case State::PROGRAM_STATUS:
+    case State::EVENTS_DRAIN:
+    case State::EVENTS_PUSH:
+    case State::SENSOR_META:
+    case State::SET_CALIBRATION:
+    case State::SENSOR_HEALTH:
+    case State::UI_REDRAW:
         return static_cast<State>(byte);
     default:
         com::usart::read_clear();
-        send_err<ErrorCode::UNKNOWN_CMD>();
+        send_err(ErrorCode::UNKNOWN_CMD);
         return State::NORMAL;
     }
 }
@@ -347,7 +549,7 @@ IMPL_STATE(disable_sensor) {
 IMPL_STATE(set_interval) {
     microstd::types::array_t<uint8_t, 3> buff;
     if (!read_buff<buff.size()>(buff)) {
-        send_err<ErrorCode::INVALID_INTERVAL>();
+        send_err(ErrorCode::INVALID_INTERVAL);
         return State::NORMAL;
     }
 
@@ -356,7 +558,7 @@ IMPL_STATE(set_interval) {
     for (uint8_t i = 0; i < buff.size() - 1; ++i) {
         const auto digit = buff[i];
         if (digit > '9' || digit < '0') {
-            send_err<ErrorCode::INVALID_INTERVAL_VALUE>();
+            send_err(ErrorCode::INVALID_INTERVAL_VALUE);
             return State::NORMAL;
         }
 
@@ -378,7 +580,7 @@ IMPL_STATE(set_interval) {
         m_delay = static_cast<uint32_t>(time) * 60 * 60;
         break;
     default:
-        send_err<ErrorCode::INVALID_INTERVAL_UNIT>();
+        send_err(ErrorCode::INVALID_INTERVAL_UNIT);
         return State::NORMAL;
     }
 
@@ -415,13 +617,34 @@ IMPL_STATE(list_sensors_state) {
 }
 
 IMPL_STATE(sensor_read) {
-    sensor_job([this](uint8_t id) { m_sensors.usart_send(id); });
+    sensor_job([this](uint8_t id) {
+        refresh_lazy(id);
+        m_sensors.usart_send(id);
+    });
 
     return State::NORMAL;
 }
 
 IMPL_STATE(sensor_read_all) {
-    sensor_job([this](uint8_t id) { m_sensors.usart_send_all(id); });
+    sensor_job([this](uint8_t id) {
+        refresh_lazy(id);
+        m_sensors.usart_send_all(id);
+    });
+
+    return State::NORMAL;
+}
+
+IMPL_STATE(sensor_read_rle) {
+    sensor_job([this](uint8_t id) {
+        refresh_lazy(id);
+        m_sensors.usart_send_rle(id);
+    });
+
+    return State::NORMAL;
+}
+
+IMPL_STATE(sensor_meta) {
+    sensor_job([](uint8_t id) { sensors_t::usart_send_meta(id); });
 
     return State::NORMAL;
 }
@@ -454,6 +677,27 @@ IMPL_STATE(export_config) {
         checksum += tmp;
     }
 
+    // calibrations
+    for (uint8_t i = 0; i < sensors_t::calibrations_count; ++i) {
+        const types::calibration_t& calibration = m_sensors.calibration(i);
+
+        const uint16_t values[] = {
+            static_cast<uint16_t>(calibration.c2),
+            static_cast<uint16_t>(calibration.c1),
+            static_cast<uint16_t>(calibration.offset),
+            calibration.divisor,
+        };
+
+        for (const uint16_t value : values) {
+            const auto hi = static_cast<uint8_t>(value >> 8);
+            const auto lo = static_cast<uint8_t>(value);
+
+            com::usart::send(hi);
+            com::usart::send(lo);
+            checksum += hi + lo;
+        }
+    }
+
     com::usart::send(checksum);
     send_ok();
     return State::NORMAL;
@@ -461,35 +705,198 @@ IMPL_STATE(export_config) {
 
 IMPL_STATE(import_config) {
 
-    microstd::types::array_t<uint8_t, config_size> config_buff;
-    if (!read_buff<config_size>(config_buff)) {
-        send_err<ErrorCode::INVALID_CONFIG>();
+    microstd::types::array_t<uint8_t, config_size + 1> config_buff;
+    if (!read_buff<config_buff.size()>(config_buff)) {
+        send_err(ErrorCode::INVALID_CONFIG);
         return State::NORMAL;
     }
 
-    const uint8_t checksum = config_buff[config_size - 1];
+    const uint8_t checksum = config_buff[config_size];
     uint8_t sum            = 0;
     for (uint8_t i = 0; i < config_size; ++i) {
         sum += config_buff[i];
     }
 
     if (sum != checksum) {
-        send_err<ErrorCode::CONFIG_CHECKSUM_FAILED>();
+        send_err(ErrorCode::CONFIG_CHECKSUM_FAILED);
         return State::NORMAL;
     }
 
+    constexpr uint8_t delay_offset       = sensors_t::bitarray_size() * 2;
+    constexpr uint8_t calibration_offset = delay_offset + (sizeof(uint32_t) / sizeof(uint8_t));
+
+    microstd::types::array_t<types::calibration_t, sensors_t::calibrations_count + 1> calibrations;
+    for (uint8_t i = 0; i < sensors_t::calibrations_count; ++i) {
+        if (!parse_calibration(&config_buff[calibration_offset + (i * calibration_size)], calibrations[i])) {
+            send_err(ErrorCode::INVALID_CONFIG);
+            return State::NORMAL;
+        }
+    }
+
     for (uint8_t i = 0; i < m_sensors.chunks_count(); ++i) {
         m_sensors.force_write_enable(i, config_buff[i]);
         m_sensors.force_write_watch(i, config_buff[i + m_sensors.chunks_count()]);
     }
 
-    uint32_t delay = config_buff[config_size - 4] << (8 * 0);
-    delay |= static_cast<uint32_t>(config_buff[config_size - 3]) << (8 * 1);
-    delay |= static_cast<uint32_t>(config_buff[config_size - 2]) << (8 * 2);
-    delay |= static_cast<uint32_t>(config_buff[config_size - 1]) << (8 * 3);
+    uint32_t delay = config_buff[delay_offset] << (8 * 0);
+    delay |= static_cast<uint32_t>(config_buff[delay_offset + 1]) << (8 * 1);
+    delay |= static_cast<uint32_t>(config_buff[delay_offset + 2]) << (8 * 2);
+    delay |= static_cast<uint32_t>(config_buff[delay_offset + 3]) << (8 * 3);
 
     m_delay = delay;
 
+    for (uint8_t i = 0; i < sensors_t::calibrations_count; ++i) {
+        m_sensors.force_write_calibration(i, calibrations[i]);
+    }
+
+    send_ok();
+    return State::NORMAL;
+}
+
+IMPL_STATE(program_upload) {
+    uint8_t size;
+    if (!read_int(size) || size > vm::Machine::program_capacity) {
+        send_err(ErrorCode::INVALID_PROGRAM);
+        return State::NORMAL;
+    }
+
+    microstd::types::array_t<uint8_t, vm::Machine::program_capacity + 1> program_buff;
+    if (!read_bytes(program_buff.data(), size + 1)) {
+        send_err(ErrorCode::INVALID_PROGRAM);
+        return State::NORMAL;
+    }
+
+    uint8_t sum = 0;
+    for (uint8_t i = 0; i < size; ++i) {
+        sum += program_buff[i];
+    }
+
+    if (sum != program_buff[size]) {
+        send_err(ErrorCode::INVALID_PROGRAM);
+        return State::NORMAL;
+    }
+
+    if (!m_vm.load(program_buff.data(), size)) {
+        send_err(ErrorCode::INVALID_PROGRAM);
+        return State::NORMAL;
+    }
+
+    send_ok();
+    return State::NORMAL;
+}
+
+IMPL_STATE(program_persist) {
+    m_vm.persist();
+
+    send_ok();
+    return State::NORMAL;
+}
+
+IMPL_STATE(program_status) {
+    const auto result = static_cast<uint16_t>(m_vm.result());
+
+    com::usart::send(static_cast<uint8_t>(m_vm.status()));
+    com::usart::send(static_cast<uint8_t>(result >> 8));
+    com::usart::send(static_cast<uint8_t>(result));
+
+    send_ok();
+    return State::NORMAL;
+}
+
+IMPL_STATE(events_drain) {
+    com::usart::send(m_events.size());
+    com::usart::send(m_events.take_dropped());
+
+    types::event_t event;
+    while (m_events.pop(event)) {
+        send_event(event);
+    }
+
+    send_ok();
+    return State::NORMAL;
+}
+
+IMPL_STATE(events_push) {
+    microstd::types::array_t<uint8_t, 1> buff;
+    if (!read_buff<buff.size()>(buff)) {
+        send_err(ErrorCode::INVALID_PUSH_MODE);
+        return State::NORMAL;
+    }
+
+    switch (buff[0]) {
+    case '0':
+        m_push_events = false;
+        break;
+    case '1':
+        m_push_events = true;
+        break;
+    default:
+        send_err(ErrorCode::INVALID_PUSH_MODE);
+        return State::NORMAL;
+    }
+
+    send_ok();
+    return State::NORMAL;
+}
+
+IMPL_STATE(set_calibration) {
+    uint8_t id;
+    uint8_t field;
+    if (!read_int(id) || !read_int(field)) {
+        send_err(ErrorCode::INVALID_CALIBRATION);
+        return State::NORMAL;
+    }
+
+    microstd::types::array_t<uint8_t, calibration_size + 1> buff;
+    if (!read_buff<buff.size()>(buff)) {
+        send_err(ErrorCode::INVALID_CALIBRATION);
+        return State::NORMAL;
+    }
+
+    uint8_t sum = 0;
+    for (uint8_t i = 0; i < calibration_size; ++i) {
+        sum += buff[i];
+    }
+
+    types::calibration_t calibration;
+    if (sum != buff[calibration_size] || !parse_calibration(buff.data(), calibration)
+        || !m_sensors.set_calibration(id, field, calibration)) {
+        send_err(ErrorCode::INVALID_CALIBRATION);
+        return State::NORMAL;
+    }
+
+    send_ok();
+    return State::NORMAL;
+}
+
+IMPL_STATE(sensor_health) {
+    com::usart::send(m_sensors.size());
+    send_u16(timer_clock_t::ticks_per_ms);
+
+    for (uint8_t id = 0; id < m_sensors.size(); ++id) {
+        const types::sensor_stats_t& stats = m_sensors.stats(id);
+
+        send_u16(stats.successes);
+        send_u16(stats.failures);
+        com::usart::send(stats.consecutive_failures);
+        send_u16(stats.min_duration());
+        send_u16(stats.avg_duration());
+        send_u16(stats.max_duration());
+    }
+
+    send_ok();
+    return State::NORMAL;
+}
+
+IMPL_STATE(ui_redraw) {
+    if constexpr (UI) {
+        send_u16(m_ui.redraw_ticks());
+        send_u16(m_ui.redraw_max_ticks());
+    } else {
+        send_u16(0);
+        send_u16(0);
+    }
+
     send_ok();
     return State::NORMAL;
 }
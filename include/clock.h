@@ -0,0 +1,54 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <microstd/mcu/io.h>
+#include <microstd/time/timer.h>
+#include <stdint.h>
+#include <util/atomic.h>
+
+/*
+ * The Timer1 compare interrupt counts the milliseconds. A pending interrupt waits while the interrupts are disabled, so
+ * a tick is lost only when they stay disabled for more than 1 ms; the clock is then behind by the lost ticks. The
+ * drivers keep their critical sections to a single bit or time slot (about 100 us).
+ */
+extern uint32_t g_millis;
+extern uint32_t g_uptime;
+
+/**
+ * @brief Gets the milliseconds since the start. The interrupt state of the caller is kept.
+ */
+inline uint32_t millis() {
+    uint32_t now;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { now = g_millis; }
+
+    return now;
+}
+
+/**
+ * @brief Clock of the measurement statistics, counts the Timer1 ticks (64 CPU cycles) since the start. The interrupt
+ * state of the caller is kept.
+ */
+struct timer_clock_t {
+    static constexpr uint16_t ticks_per_ms = F_CPU / 64 / 1000;
+
+    static uint32_t ticks() {
+        using timer_t = microstd::time::CountTimer<microstd::mcu::io::Timer1>;
+
+        uint32_t now;
+        uint16_t value;
+
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            now   = g_millis;
+            value = microstd::mcu::io::Timer1::get_value();
+
+            // the timer already restarted, but the interrupt did not increment the milliseconds yet
+            if (timer_t::flag() && value < ticks_per_ms / 2) {
+                now += 1;
+            }
+        }
+
+        return (now * ticks_per_ms) + value;
+    }
+};
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef COM_TWI_H
+#define COM_TWI_H
+
+#include <stdint.h>
+
+#ifndef F_CPU
+#    error F_CPU must be defined
+#endif
+
+namespace com::twi {
+
+/**
+ * @brief Size of the transfer queue in bytes (a power of 2), every transfer takes 2 extra bytes for its header.
+ */
+constexpr uint8_t QUEUE_SIZE = 64;
+
+/**
+ * @brief Initializes the TWI (I2C) master.
+ *
+ * @param frequency The SCL frequency in Hz (e.g. 400000 for the fast mode).
+ */
+void init(uint32_t frequency);
+
+/**
+ * @brief Gets the number of bytes which can be queued.
+ */
+uint8_t available();
+
+/**
+ * @brief Reserves a write transfer in the queue, the transfer must be filled with `push` and queued with `end`.
+ *
+ * @param address The 7-bit address of the device.
+ * @param size The number of the transferred bytes.
+ * @return false if the queue does not have space for the transfer.
+ */
+bool begin(uint8_t address, uint8_t size);
+
+/**
+ * @brief Appends a byte to the reserved transfer.
+ *
+ * @param byte The byte to be sent.
+ */
+void push(uint8_t byte);
+
+/**
+ * @brief Queues the reserved transfer and starts the transmission if the bus is idle.
+ *
+ * The queued transfers are sent from the TWI interrupt, so the interrupts must be enabled.
+ */
+void end();
+
+/**
+ * @brief Checks whether all queued transfers were sent.
+ */
+bool idle();
+
+/**
+ * @brief Gets the number of bytes queued for the bus including the address bytes, the counter wraps around.
+ */
+uint16_t queued_bytes();
+
+/**
+ * @brief Gets the number of transfers which were not acknowledged by the device (saturates at 255).
+ */
+uint8_t errors();
+
+}
+
+#endif
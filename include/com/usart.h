@@ -1,6 +1,8 @@
 #ifndef COM_USART_H
 #define COM_USART_H
 
+#include "types/flash_string.h"
+
 #include <microstd/mcu/io.h>
 #include <microstd/time/timer.h>
 
@@ -92,6 +94,13 @@ uint8_t read_unsafe();
  */
 void send(const char* msg);
 
+/**
+ * @brief Sends a null-terminated string stored in the program memory over USART.
+ *
+ * @param msg The string to be sent.
+ */
+void send(types::flash_string msg);
+
 /**
  * @brief Sends a byte as two hexadecimal characters over USART.
  *
@@ -1,10 +1,470 @@
 #ifndef COMPONENT_DISPLAY_SSD1306_H
 #define COMPONENT_DISPLAY_SSD1306_H
 
+#include <avr/pgmspace.h>
+#include <stdint.h>
+
+#include "com/twi.h"
+#include "component/display/font.h"
+#include "types/flash_string.h"
+
 namespace component::display {
 
+/**
+ * @brief Text mode driver of the 128x64 SSD1306 OLED display on the TWI bus.
+ *
+ * The drawing functions only change the text buffer and mark the changed cells. `flush` turns the runs of the changed
+ * cells of a page into batched page writes and queues as many of them as fit into the TWI queue, the interrupt
+ * handler transmits them. So nothing waits for the bus, the rest of the cells is sent by the next `flush`.
+ *
+ * The graph mode replaces the text below the first row by a line graph with one point per pixel column. Only the
+ * columns whose point or whose left neighbour changed are sent.
+ */
 class SSD1306 {
 public:
+    static constexpr uint8_t address    = 0x3C;
+    static constexpr uint32_t frequency = 400000;
+    static constexpr uint8_t width      = 128;
+    static constexpr uint8_t pages      = 8;
+    static constexpr uint8_t cell_width = FONT_GLYPH_SIZE + 1;
+    static constexpr uint8_t columns    = width / cell_width;
+    static constexpr uint16_t ram_size  = static_cast<uint16_t>(width) * pages;
+
+    static_assert(columns <= 32, "The changed cells of a page are stored in 32 bits");
+
+    /**
+     * @brief The graph takes the pages below the first text row.
+     */
+    static constexpr uint8_t graph_page   = 1;
+    static constexpr uint8_t graph_height = (pages - graph_page) * 8;
+    static constexpr uint8_t no_point     = 0xFF;
+
+    /**
+     * @brief Initializes the bus and queues the initialization of the display, the display is cleared by `flush`.
+     */
+    void init() {
+        com::twi::init(frequency);
+
+        com::twi::begin(address, sizeof(init_sequence) + 1);
+        com::twi::push(COMMAND);
+        for (uint8_t i = 0; i < sizeof(init_sequence); ++i) {
+            com::twi::push(pgm_read_byte(&init_sequence[i]));
+        }
+        com::twi::end();
+
+        for (uint8_t y = 0; y < pages; ++y) {
+            for (uint8_t x = 0; x < columns; ++x) {
+                m_text[y][x] = ' ';
+            }
+            m_changed[y] = 0;
+        }
+
+        for (uint8_t x = 0; x < width; ++x) {
+            m_plot[x] = no_point;
+        }
+
+        for (uint8_t i = 0; i < sizeof(m_plot_changed); ++i) {
+            m_plot_changed[i] = 0;
+        }
+
+        m_graph       = false;
+        m_x           = 0;
+        m_y           = 0;
+        m_blank       = ram_size;
+        m_display_on  = true;
+        m_power_state = true;
+    }
+
+    /**
+     * @brief Clears the display and moves the cursor home.
+     */
+    void clear() {
+        for (uint8_t y = 0; y < pages; ++y) {
+            for (uint8_t x = 0; x < columns; ++x) {
+                set_cell(x, y, ' ');
+            }
+        }
+
+        home();
+    }
+
+    void home() { goto_xy(0, 0); }
+
+    /**
+     * @brief Moves the cursor.
+     *
+     * @param x The column of the character.
+     * @param y The page (text row).
+     */
+    void goto_xy(uint8_t x, uint8_t y) {
+        m_x = x;
+        m_y = y;
+    }
+
+    /**
+     * @brief Writes the character at the cursor, the characters out of the display are dropped.
+     */
+    void putc(char c) {
+        if (m_x < columns && m_y < pages) {
+            set_cell(m_x, m_y, (c < FONT_FIRST_CHAR || c > FONT_LAST_CHAR) ? ' ' : c);
+        }
+
+        m_x += 1;
+    }
+
+    void puts(const char* str) {
+        while (*str != '\0') {
+            putc(*str);
+            str += 1;
+        }
+    }
+
+    /**
+     * @brief Writes a string stored in the program memory (PROGMEM).
+     */
+    void puts(types::flash_string str) {
+        for (uint8_t i = 0; str[i] != '\0'; ++i) {
+            putc(str[i]);
+        }
+    }
+
+    /**
+     * @brief Shows or hides the graph, the hidden text is kept and redrawn when the graph is hidden.
+     */
+    void graph(bool enable) {
+        if (enable == m_graph) {
+            return;
+        }
+
+        m_graph = enable;
+
+        if (enable) {
+            for (uint8_t i = 0; i < sizeof(m_plot_changed); ++i) {
+                m_plot_changed[i] = 0xFF;
+            }
+        } else {
+            for (uint8_t y = graph_page; y < pages; ++y) {
+                m_changed[y] = (1UL << columns) - 1;
+            }
+        }
+    }
+
+    /**
+     * @brief Sets the point of the graph column, the column is drawn as a vertical line from the point of the previous
+     * column.
+     *
+     * @param x The pixel column.
+     * @param y The height from the bottom (less than `graph_height`) or `no_point`.
+     */
+    void plot(uint8_t x, uint8_t y) {
+        if (m_plot[x] == y) {
+            return;
+        }
+
+        m_plot[x] = y;
+        mark_column(x);
+        if (x + 1 < width) {
+            mark_column(x + 1);
+        }
+    }
+
+    /**
+     * @brief Turns the display off (sleep) or on, the text buffer is kept.
+     */
+    void sleep(bool enable) { m_display_on = !enable; }
+
+    /**
+     * @brief Queues the pending changes which fit into the TWI queue.
+     */
+    void flush() {
+        if (m_power_state != m_display_on) {
+            if (!com::twi::begin(address, 2)) {
+                return;
+            }
+
+            com::twi::push(COMMAND);
+            com::twi::push(m_display_on ? DISPLAY_ON : DISPLAY_OFF);
+            com::twi::end();
+
+            m_power_state = m_display_on;
+        }
+
+        // the initialization set the window to the whole memory
+        while (m_blank > 0) {
+            const uint8_t space = com::twi::available();
+            if (space <= DATA_OVERHEAD) {
+                return;
+            }
+
+            const uint8_t size = (m_blank < space - DATA_OVERHEAD) ? m_blank : space - DATA_OVERHEAD;
+
+            com::twi::begin(address, size + 1);
+            com::twi::push(DATA);
+            for (uint8_t i = 0; i < size; ++i) {
+                com::twi::push(0);
+            }
+            com::twi::end();
+
+            m_blank -= size;
+        }
+
+        const uint8_t text_pages = m_graph ? graph_page : pages;
+        for (uint8_t y = 0; y < text_pages; ++y) {
+            while (m_changed[y] != 0) {
+                if (!flush_run(y)) {
+                    return;
+                }
+            }
+        }
+
+        if (m_graph) {
+            while (plot_changed()) {
+                if (!flush_plot_run()) {
+                    return;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Checks whether all changes were queued.
+     */
+    [[nodiscard]] bool flushed() const {
+        const uint8_t text_pages = m_graph ? graph_page : pages;
+        for (uint8_t y = 0; y < text_pages; ++y) {
+            if (m_changed[y] != 0) {
+                return false;
+            }
+        }
+
+        if (m_graph && plot_changed()) {
+            return false;
+        }
+
+        return m_blank == 0 && m_power_state == m_display_on;
+    }
+
+private:
+    // control bytes
+    static constexpr uint8_t COMMAND = 0x00;
+    static constexpr uint8_t DATA    = 0x40;
+
+    static constexpr uint8_t DISPLAY_OFF   = 0xAE;
+    static constexpr uint8_t DISPLAY_ON    = 0xAF;
+    static constexpr uint8_t COLUMN_WINDOW = 0x21;
+    static constexpr uint8_t PAGE_WINDOW   = 0x22;
+
+    // transfer header and the control byte
+    static constexpr uint8_t DATA_OVERHEAD   = 3;
+    static constexpr uint8_t WINDOW_TRANSFER = 2 + 7;
+
+    /**
+     * @brief 128x64 panel with the charge pump, the horizontal addressing and the window over the whole memory.
+     */
+    static constexpr uint8_t init_sequence[] PROGMEM = {
+        DISPLAY_OFF,
+        0xD5, 0x80, // clock divider
+        0xA8, 0x3F, // multiplex ratio 64
+        0xD3, 0x00, // display offset
+        0x40,       // start line 0
+        0x8D, 0x14, // charge pump
+        0x20, 0x00, // horizontal addressing
+        0xA1,       // segment remap
+        0xC8,       // COM scan direction
+        0xDA, 0x12, // COM pins
+        0x81, 0xCF, // contrast
+        0xD9, 0xF1, // precharge period
+        0xDB, 0x40, // VCOMH level
+        0xA4,       // display the memory
+        0xA6,       // normal (not inverted)
+        COLUMN_WINDOW, 0, width - 1,
+        PAGE_WINDOW, 0, pages - 1,
+        DISPLAY_ON,
+    };
+
+    void set_cell(uint8_t x, uint8_t y, char c) {
+        if (m_text[y][x] != c) {
+            m_text[y][x] = c;
+            m_changed[y] |= 1UL << x;
+        }
+    }
+
+    /**
+     * @brief Queues the first run of the changed cells of the page as one page write, a run which does not fit is
+     * split.
+     *
+     * @return false if the queue is full.
+     */
+    bool flush_run(uint8_t y) {
+        const uint32_t changed = m_changed[y];
+
+        uint8_t first = 0;
+        while ((changed & (1UL << first)) == 0) {
+            first += 1;
+        }
+
+        uint8_t count = 1;
+        while (first + count < columns && (changed & (1UL << (first + count))) != 0) {
+            count += 1;
+        }
+
+        const uint8_t space = com::twi::available();
+        if (space < WINDOW_TRANSFER + DATA_OVERHEAD + cell_width) {
+            return false;
+        }
+
+        const uint8_t fit = (space - WINDOW_TRANSFER - DATA_OVERHEAD) / cell_width;
+        if (count > fit) {
+            count = fit;
+        }
+
+        const uint8_t start = first * cell_width;
+        const uint8_t size  = count * cell_width;
+
+        com::twi::begin(address, 7);
+        com::twi::push(COMMAND);
+        com::twi::push(COLUMN_WINDOW);
+        com::twi::push(start);
+        com::twi::push(start + size - 1);
+        com::twi::push(PAGE_WINDOW);
+        com::twi::push(y);
+        com::twi::push(y);
+        com::twi::end();
+
+        com::twi::begin(address, size + 1);
+        com::twi::push(DATA);
+        for (uint8_t x = first; x < first + count; ++x) {
+            const uint8_t* glyph = &font_5x8[(m_text[y][x] - FONT_FIRST_CHAR) * FONT_GLYPH_SIZE];
+
+            for (uint8_t i = 0; i < FONT_GLYPH_SIZE; ++i) {
+                com::twi::push(pgm_read_byte(&glyph[i]));
+            }
+            com::twi::push(0);
+        }
+        com::twi::end();
+
+        m_changed[y] &= ~(((1UL << count) - 1) << first);
+        return true;
+    }
+
+    void mark_column(uint8_t x) { m_plot_changed[x / 8] |= static_cast<uint8_t>(1 << (x % 8)); }
+
+    [[nodiscard]] bool column_changed(uint8_t x) const { return (m_plot_changed[x / 8] & (1 << (x % 8))) != 0; }
+
+    [[nodiscard]] bool plot_changed() const {
+        for (uint8_t i = 0; i < sizeof(m_plot_changed); ++i) {
+            if (m_plot_changed[i] != 0) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Gets the byte of the graph column in the page, the top row is the lowest bit.
+     */
+    [[nodiscard]] uint8_t column_byte(uint8_t x, uint8_t page) const {
+        const uint8_t y = m_plot[x];
+        if (y == no_point) {
+            return 0;
+        }
+
+        uint8_t low  = y;
+        uint8_t high = y;
+
+        const uint8_t previous = (x > 0) ? m_plot[x - 1] : no_point;
+        if (previous != no_point) {
+            low  = (previous < low) ? previous : low;
+            high = (previous > high) ? previous : high;
+        }
+
+        // rows from the top of the graph
+        const uint8_t top    = graph_height - 1 - high;
+        const uint8_t bottom = graph_height - 1 - low;
+        const uint8_t first  = (page - graph_page) * 8;
+
+        uint8_t byte = 0;
+        for (uint8_t bit = 0; bit < 8; ++bit) {
+            const uint8_t row = first + bit;
+            if (row >= top && row <= bottom) {
+                byte |= static_cast<uint8_t>(1 << bit);
+            }
+        }
+
+        return byte;
+    }
+
+    /**
+     * @brief Queues the first run of the changed graph columns as one write of all graph pages.
+     *
+     * @return false if the queue is full.
+     */
+    bool flush_plot_run() {
+        constexpr uint8_t graph_pages = pages - graph_page;
+
+        uint8_t first = 0;
+        while (!column_changed(first)) {
+            first += 1;
+        }
+
+        uint8_t count = 1;
+        while (first + count < width && column_changed(first + count)) {
+            count += 1;
+        }
+
+        const uint8_t space = com::twi::available();
+        if (space < WINDOW_TRANSFER + DATA_OVERHEAD + graph_pages) {
+            return false;
+        }
+
+        const uint8_t fit = (space - WINDOW_TRANSFER - DATA_OVERHEAD) / graph_pages;
+        if (count > fit) {
+            count = fit;
+        }
+
+        com::twi::begin(address, 7);
+        com::twi::push(COMMAND);
+        com::twi::push(COLUMN_WINDOW);
+        com::twi::push(first);
+        com::twi::push(first + count - 1);
+        com::twi::push(PAGE_WINDOW);
+        com::twi::push(graph_page);
+        com::twi::push(pages - 1);
+        com::twi::end();
+
+        // the horizontal addressing fills the window page by page
+        com::twi::begin(address, (count * graph_pages) + 1);
+        com::twi::push(DATA);
+        for (uint8_t page = graph_page; page < pages; ++page) {
+            for (uint8_t x = first; x < first + count; ++x) {
+                com::twi::push(column_byte(x, page));
+            }
+        }
+        com::twi::end();
+
+        for (uint8_t x = first; x < first + count; ++x) {
+            m_plot_changed[x / 8] &= static_cast<uint8_t>(~(1 << (x % 8)));
+        }
+
+        return true;
+    }
+
+    char m_text[pages][columns];
+    uint32_t m_changed[pages];
+
+    uint8_t m_plot[width];
+    uint8_t m_plot_changed[width / 8];
+    bool m_graph = false;
+
+    uint8_t m_x = 0;
+    uint8_t m_y = 0;
+
+    // zero bytes left to clear the memory after the initialization
+    uint16_t m_blank = 0;
+
+    bool m_display_on  = true;
+    bool m_power_state = true;
 };
 
 }
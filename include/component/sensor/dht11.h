@@ -7,8 +7,10 @@
 #include <microstd/types/array.h>
 
 #include <stdint.h>
+#include <util/atomic.h>
 #include <util/delay.h>
 
+#include "types/io_pin.h"
 #include "types/sensor_pin.h"
 
 namespace component::sensor {
@@ -20,113 +22,227 @@ struct dht11_data_t {
     uint8_t temperature_dec;
 };
 
+/**
+ * @brief The DHT11 protocol.
+ *
+ * The data line is accessed through the `Line` type, which provides `release()`, `pull_low()` and the timed waits
+ * `wait_until_on<Us>(count)`/`wait_until_off<Us>(count)` returning the timer value when the level was reached.
+ */
+struct dht11_protocol {
+    /**
+     * @brief The duration of the start signal in milliseconds (at least 18 ms).
+     */
+    static constexpr uint8_t start_time = 19;
+
+    /**
+     * @brief Ends the start signal and reads the measured data.
+     *
+     * @param line The data line.
+     * @param data Reference to the output data.
+     * @return false if the sensor did not respond or the checksum does not match.
+     */
+    template <typename Line> static bool read(const Line& line, dht11_data_t& data) {
+        microstd::types::array_t<uint8_t, 5> raw_data;
+        if (!receive(line, raw_data)) {
+            return false;
+        }
+
+        // checksum
+        if (raw_data[0] + raw_data[1] + raw_data[2] + raw_data[3] != raw_data[4]) {
+            return false;
+        }
+
+        data.humidity_int    = raw_data[0];
+        data.humidity_dec    = raw_data[1];
+        data.temperature_int = raw_data[2];
+        data.temperature_dec = raw_data[3];
+
+        return true;
+    }
+
+private:
+    /*
+     * Bit format:
+     * +-------+--------------+--------------+
+     * |  Bit  |  High (µs)   | Low (µs)     |
+     * +-------+--------------+--------------+
+     * |   0   |   ~26-28     |     ~50      |
+     * |   1   |     ~70      |     ~50      |
+     * +-------+--------------+--------------+
+     * A bit is 1 if its high time is longer than half of the ~80 us high time of the response, which is measured in
+     * the same timer unit.
+     *
+     * Only the high times are measured with the interrupts disabled (at most 100 us each), so the clock and the USART
+     * keep running during the transfer. An interrupt in the low time only delays the start of the high measurement,
+     * which shortens the measured high time a little: a 1 stays above the half of the response and a 0 below.
+     */
+    template <typename Line> static bool receive(const Line& line, microstd::types::array_t<uint8_t, 5>& raw_data) {
+        uint8_t reference = 0;
+        bool ok = false;
+
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            line.release();
+
+            uint8_t tmp;
+            // ~80us low signal, then the ~80us high signal
+            ok = line.template wait_until_off<20>(tmp) && line.template wait_until_on<100>(tmp)
+                && line.template wait_until_off<100>(reference);
+        }
+
+        if (!ok) {
+            return false;
+        }
+
+        const uint8_t threshold = reference / 2;
+
+        for (uint8_t b = 0; b < 5; ++b) {
+            uint8_t byte = 0;
+            for (uint8_t i = 0; i < 8; ++i) {
+                uint8_t low;
+                // ~50us low signal
+                if (!line.template wait_until_on<75>(low)) {
+                    return false;
+                }
+
+                uint8_t high;
+                ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { ok = line.template wait_until_off<100>(high); }
+
+                if (!ok) {
+                    return false;
+                }
+
+                if (high > threshold) {
+                    byte |= 1 << (7 - i);
+                }
+            }
+            raw_data[b] = byte;
+        }
+
+        return true;
+    }
+};
+
 template <types::sensor_pin Pin, microstd::time::avr::is_avr_timer Timer> class dht11 {
 private:
     using timer_t  = Timer;
     using pin_info = Pin;
 
-    template <bool WaitUntilOn, uint8_t Us> static bool wait_until(uint8_t& count) {
-        return wait_timeout<
-            WaitUntilOn,
-            typename Pin::pin_bit,
-            timer_t,
-            microstd::time::avr::ClockSource256,
-            microstd::time::Microseconds<Us>>(count);
-    }
+    struct line_t {
+        void release() const {
+            pin_info::port_bit::set();
+            pin_info::ddr_bit::unset();
+        }
 
-    template <uint8_t Us> static bool wait_until_on(uint8_t& count) {
-        bool res
-            = microstd::time::wait_for_bit_on<typename pin_info::pin_bit, timer_t, microstd::time::Microseconds<Us>>();
+        template <uint8_t Us> bool wait_until_on(uint8_t& count) const {
+            using unit_t = microstd::time::Microseconds<Us>;
+            bool res     = microstd::time::wait_for_bit_on<typename pin_info::pin_bit, timer_t, unit_t>();
 
-        count = timer_t::get_value();
-        return res;
-    }
-
-    template <uint8_t Us> static bool wait_until_off(uint8_t& count) {
-        bool res
-            = microstd::time::wait_for_bit_off<typename pin_info::pin_bit, timer_t, microstd::time::Microseconds<Us>>();
+            count = timer_t::get_value();
+            return res;
+        }
 
-        count = timer_t::get_value();
-        return res;
-    }
+        template <uint8_t Us> bool wait_until_off(uint8_t& count) const {
+            using unit_t = microstd::time::Microseconds<Us>;
+            bool res     = microstd::time::wait_for_bit_off<typename pin_info::pin_bit, timer_t, unit_t>();
 
-    using raw_data_t = microstd::types::array_t<uint8_t, 5>;
+            count = timer_t::get_value();
+            return res;
+        }
+    };
 
 public:
+    static constexpr uint8_t start_time = dht11_protocol::start_time;
+
     static void prepare() {
         pin_info::port_bit::set();
         pin_info::ddr_bit::unset();
     }
 
     static bool measure(dht11_data_t& data) {
-        raw_data_t raw_data;
+        start();
+
+        _delay_ms(start_time);
 
+        return read(data);
+    }
+
+    /**
+     * @brief Starts the measurement by pulling the line low. The `read` must be called after `start_time`.
+     */
+    static void start() {
         pin_info::port_bit::unset();
         pin_info::ddr_bit::set();
+    }
 
-        // wait atleast 18ms
-        _delay_ms(19);
+    /**
+     * @brief Ends the start signal and reads the measured data.
+     *
+     * @param data Reference to the output data.
+     * @return false if the sensor did not respond or the checksum does not match.
+     */
+    static bool read(dht11_data_t& data) { return dht11_protocol::read(line_t {}, data); }
+};
 
-        pin_info::port_bit::set();
-        pin_info::ddr_bit::unset();
+/**
+ * @brief DHT11 on a pin selected at runtime. All sensors of a sensor array share this code.
+ *
+ * @tparam Timer The timer used for the timed waits.
+ */
+template <microstd::time::avr::is_avr_timer Timer> class dht11_pin {
+private:
+    using timer_t = microstd::time::CountTimer<Timer>;
 
-        uint8_t tmp;
-        if (!wait_until_off<20>(tmp)) {
-            return false;
-        }
+    struct line_t {
+        types::io_pin_t pin;
 
-        // ~80us low signal
-        if (!wait_until_on<100>(tmp)) {
-            return false;
+        void release() const {
+            pin.port_set();
+            pin.ddr_unset();
         }
 
-        // ~80us high signal
-        if (!wait_until_off<100>(tmp)) {
-            return false;
-        }
+        template <uint8_t Us> bool wait_until_on(uint8_t& count) const { return wait_until<true, Us>(count); }
 
-        for (uint8_t b = 0; b < 5; ++b) {
-            uint8_t byte = 0;
-            for (uint8_t i = 0; i < 8; ++i) {
-                uint8_t low;
-                // ~50us signal
-                if (!wait_until_on<75>(low)) {
-                    return false;
-                }
+        template <uint8_t Us> bool wait_until_off(uint8_t& count) const { return wait_until<false, Us>(count); }
 
-                uint8_t high;
-                if (!wait_until_off<100>(high)) {
-                    return false;
-                }
+        template <bool On, uint8_t Us> bool wait_until(uint8_t& count) const {
+            timer_t::init();
+            timer_t::template start<microstd::time::avr::ClockSource8, microstd::time::Microseconds<Us>>();
 
-                /*
-                 * Bit format:
-                 * +-------+--------------+--------------+
-                 * |  Bit  |  High (µs)   | Low (µs)     |
-                 * +-------+--------------+--------------+
-                 * |   0   |   ~26-28     |     ~50      |
-                 * |   1   |     ~70      |     ~50      |
-                 * +-------+--------------+--------------+
-                 * Bits are determined by comparing high and low durations.
-                 */
-                if (low <= high) {
-                    byte |= 1 << (7 - i);
+            do {
+                if (pin.read() == On) {
+                    count = Timer::get_value();
+                    return true;
                 }
-            }
-            raw_data[b] = byte;
-        }
+            } while (!timer_t::flag());
 
-        // checksum
-        if (raw_data[0] + raw_data[1] + raw_data[2] + raw_data[3] != raw_data[4]) {
+            count = Timer::get_value();
             return false;
         }
+    };
 
-        data.humidity_int    = raw_data[0];
-        data.humidity_dec    = raw_data[1];
-        data.temperature_int = raw_data[2];
-        data.temperature_dec = raw_data[3];
+public:
+    static constexpr uint8_t start_time = dht11_protocol::start_time;
 
-        return true;
+    static void prepare(types::io_pin_t pin) {
+        pin.port_set();
+        pin.ddr_unset();
+    }
+
+    static bool measure(types::io_pin_t pin, dht11_data_t& data) {
+        start(pin);
+
+        _delay_ms(start_time);
+
+        return read(pin, data);
+    }
+
+    static void start(types::io_pin_t pin) {
+        pin.port_unset();
+        pin.ddr_set();
+    }
+
+    static bool read(types::io_pin_t pin, dht11_data_t& data) {
+        return dht11_protocol::read(line_t { .pin = pin }, data);
     }
 };
 
@@ -0,0 +1,96 @@
+#ifndef COMPONENT_SENSOR_DS18B20_H
+#define COMPONENT_SENSOR_DS18B20_H
+
+#include <microstd/types/array.h>
+#include <stdint.h>
+
+#include "component/sensor/one_wire.h"
+
+namespace component::sensor {
+
+/**
+ * @brief DS18B20 temperature probes on a 1-Wire bus.
+ *
+ * The conversion is started on all probes at once and the bus is polled until it is done, so nothing waits for the
+ * conversion time. The probes must be powered externally (not by the parasite power), a converting probe holds the
+ * read time slots low.
+ *
+ * @tparam Bus The bus (`OneWire<...>`).
+ */
+template <typename Bus> struct ds18b20 {
+    static constexpr uint8_t family = 0x28;
+
+    /**
+     * @brief The longest conversion time (12-bit resolution) in milliseconds.
+     */
+    static constexpr uint16_t conversion_time = 750;
+
+    /**
+     * @brief Starts the conversion on all probes on the bus.
+     *
+     * @return false if no probe is present.
+     */
+    static bool convert_all() {
+        if (!Bus::reset()) {
+            return false;
+        }
+
+        Bus::skip();
+        Bus::write(CONVERT_T);
+        return true;
+    }
+
+    /**
+     * @brief Checks the conversion in a single time slot.
+     *
+     * @return true if all probes finished the conversion.
+     */
+    static bool conversion_done() { return Bus::read_bit(); }
+
+    /**
+     * @brief Reads the converted temperature of the probe.
+     *
+     * @param rom The ROM code of the probe.
+     * @param temperature Reference to the temperature in 1/16 degree Celsius.
+     * @return false if the probe did not answer, the scratchpad CRC does not match or the bus is stuck low.
+     */
+    static bool read(const one_wire_rom_t& rom, int16_t& temperature) {
+        if (!Bus::reset()) {
+            return false;
+        }
+
+        Bus::select(rom);
+        Bus::write(READ_SCRATCHPAD);
+
+        microstd::types::array_t<uint8_t, 9> scratchpad;
+        uint8_t any = 0;
+        for (uint8_t i = 0; i < scratchpad.size(); ++i) {
+            scratchpad[i] = Bus::read();
+            any |= scratchpad[i];
+        }
+
+        // the configuration register has fixed ones, so only a bus stuck low reads as zeros (with a zero CRC)
+        if (any == 0 || one_wire_crc8(scratchpad.data(), 8) != scratchpad[8]) {
+            return false;
+        }
+
+        temperature = static_cast<int16_t>(scratchpad[0] | (scratchpad[1] << 8));
+        return true;
+    }
+
+    /**
+     * @brief Converts the raw temperature (1/16 C) to tenths of degree Celsius, rounded to the nearest.
+     */
+    static int16_t to_tenths(int16_t raw) {
+        const int32_t scaled = static_cast<int32_t>(raw) * 10;
+        return static_cast<int16_t>((scaled >= 0) ? (scaled + 8) / 16 : (scaled - 8) / 16);
+    }
+
+private:
+    static constexpr uint8_t CONVERT_T       = 0x44;
+    static constexpr uint8_t READ_SCRATCHPAD = 0xBE;
+};
+
+}
+
+#endif
@@ -0,0 +1,246 @@
+#ifndef COMPONENT_SENSOR_ONE_WIRE_H
+#define COMPONENT_SENSOR_ONE_WIRE_H
+
+#include <microstd/concepts.h>
+#include <microstd/mcu/io.h>
+#include <microstd/types/array.h>
+
+#include <stdint.h>
+#include <util/delay.h>
+
+#include "types/sensor_pin.h"
+
+namespace component::sensor {
+
+/**
+ * @brief ROM code of a 1-Wire device (family code, 48-bit serial number and CRC).
+ */
+using one_wire_rom_t = microstd::types::array_t<uint8_t, 8>;
+
+/**
+ * @brief Dallas/Maxim CRC-8 (x^8 + x^5 + x^4 + 1) of the ROM codes and the scratchpads.
+ *
+ * The CRC of zeros is zero, so the all-zero data of a shorted bus must be rejected separately.
+ */
+inline uint8_t one_wire_crc8(const uint8_t* data, uint8_t size) {
+    uint8_t crc = 0;
+
+    for (uint8_t i = 0; i < size; ++i) {
+        uint8_t byte = data[i];
+
+        for (uint8_t b = 0; b < 8; ++b) {
+            const bool mix = ((crc ^ byte) & 1) != 0;
+
+            crc >>= 1;
+            if (mix) {
+                crc ^= 0x8C;
+            }
+
+            byte >>= 1;
+        }
+    }
+
+    return crc;
+}
+
+/**
+ * @brief 1-Wire line on a pin with an external pull-up resistor.
+ */
+template <types::sensor_pin Pin> struct OneWirePin {
+    static void release() { Pin::ddr_bit::unset(); }
+
+    static void pull_low() {
+        Pin::port_bit::unset();
+        Pin::ddr_bit::set();
+    }
+
+    static bool read() { return (Pin::pin::read() & Pin::pin_bit::bit) != 0; }
+};
+
+template <typename T>
+concept one_wire_line = requires {
+    { T::release() } -> microstd::same_as<void>;
+    { T::pull_low() } -> microstd::same_as<void>;
+    { T::read() } -> microstd::same_as<bool>;
+};
+
+/**
+ * @brief 1-Wire bus master.
+ *
+ * Every time slot runs with the interrupts disabled, so a slot takes at most ~70 us of the interrupt latency and the
+ * interrupts are served between the slots.
+ *
+ * @tparam Line The line, see `OneWirePin`.
+ */
+template <one_wire_line Line> class OneWire {
+public:
+    enum class Command : uint8_t {
+        SEARCH_ROM = 0xF0,
+        MATCH_ROM  = 0x55,
+        SKIP_ROM   = 0xCC,
+    };
+
+    static void init() { Line::release(); }
+
+    /**
+     * @brief Sends the reset pulse.
+     *
+     * @return true if a device answered with the presence pulse.
+     */
+    static bool reset() {
+        Line::pull_low();
+        _delay_us(480);
+
+        microstd::mcu::disable_interrupts();
+        Line::release();
+        _delay_us(70);
+        const bool presence = !Line::read();
+        microstd::mcu::enable_interrupts();
+
+        _delay_us(410);
+        return presence;
+    }
+
+    static void write_bit(bool bit) {
+        microstd::mcu::disable_interrupts();
+        Line::pull_low();
+
+        if (bit) {
+            _delay_us(6);
+            Line::release();
+            microstd::mcu::enable_interrupts();
+            _delay_us(64);
+        } else {
+            _delay_us(60);
+            Line::release();
+            microstd::mcu::enable_interrupts();
+            _delay_us(10);
+        }
+    }
+
+    static bool read_bit() {
+        microstd::mcu::disable_interrupts();
+        Line::pull_low();
+        _delay_us(6);
+        Line::release();
+        _delay_us(9);
+        const bool bit = Line::read();
+        microstd::mcu::enable_interrupts();
+
+        _delay_us(55);
+        return bit;
+    }
+
+    static void write(uint8_t byte) {
+        for (uint8_t i = 0; i < 8; ++i) {
+            write_bit((byte & (1 << i)) != 0);
+        }
+    }
+
+    static void write(Command command) { write(static_cast<uint8_t>(command)); }
+
+    static uint8_t read() {
+        uint8_t byte = 0;
+        for (uint8_t i = 0; i < 8; ++i) {
+            if (read_bit()) {
+                byte |= 1 << i;
+            }
+        }
+
+        return byte;
+    }
+
+    /**
+     * @brief Addresses the device with the ROM code, must follow the reset.
+     */
+    static void select(const one_wire_rom_t& rom) {
+        write(Command::MATCH_ROM);
+        for (uint8_t i = 0; i < rom.size(); ++i) {
+            write(rom[i]);
+        }
+    }
+
+    /**
+     * @brief Addresses all devices at once, must follow the reset.
+     */
+    static void skip() { write(Command::SKIP_ROM); }
+
+    /**
+     * @brief Enumerates the ROM codes of the devices on the bus (the search algorithm from Maxim AN187).
+     */
+    class search_t {
+    public:
+        /**
+         * @brief Finds the next device.
+         *
+         * @param rom Reference to the output ROM code.
+         * @return false if there is no other device or the bus failed.
+         */
+        bool next(one_wire_rom_t& rom) {
+            if (m_done || !reset()) {
+                m_done = true;
+                return false;
+            }
+
+            write(Command::SEARCH_ROM);
+
+            uint8_t last_zero = 0;
+            for (uint8_t bit = 1; bit <= 64; ++bit) {
+                const uint8_t byte = (bit - 1) / 8;
+                const auto mask    = static_cast<uint8_t>(1 << ((bit - 1) % 8));
+
+                // every device sends its bit and its complement, the line is the AND of all of them
+                const bool id         = read_bit();
+                const bool complement = read_bit();
+
+                if (id && complement) {
+                    m_done = true;
+                    return false;
+                }
+
+                bool direction = id;
+                if (id == complement) {
+                    // the devices differ in this bit, take the other branch than in the previous pass
+                    if (bit < m_last_discrepancy) {
+                        direction = (m_rom[byte] & mask) != 0;
+                    } else {
+                        direction = bit == m_last_discrepancy;
+                    }
+
+                    if (!direction) {
+                        last_zero = bit;
+                    }
+                }
+
+                if (direction) {
+                    m_rom[byte] |= mask;
+                } else {
+                    m_rom[byte] &= static_cast<uint8_t>(~mask);
+                }
+
+                write_bit(direction);
+            }
+
+            m_last_discrepancy = last_zero;
+            m_done             = last_zero == 0;
+
+            // a bus stuck low reads as the all-zero ROM code, whose CRC is also zero
+            if (m_rom[0] == 0 || one_wire_crc8(m_rom.data(), 7) != m_rom[7]) {
+                m_done = true;
+                return false;
+            }
+
+            rom = m_rom;
+            return true;
+        }
+
+    private:
+        one_wire_rom_t m_rom       = {};
+        uint8_t m_last_discrepancy = 0;
+        bool m_done                = false;
+    };
+};
+
+}
+
+#endif
@@ -0,0 +1,200 @@
+#ifndef COMPONENT_SENSOR_PULSE_COUNTER_H
+#define COMPONENT_SENSOR_PULSE_COUNTER_H
+
+#include <avr/pgmspace.h>
+#include <microstd/mcu/io.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <util/atomic.h>
+
+#include "clock.h"
+#include "component/sensor/BasicSensor.h"
+#include "types/fields.h"
+#include "types/sensor_meta.h"
+#include "types/sensors.h"
+
+namespace component::sensor {
+
+/**
+ * @brief The counted edge. The value is written to the ISCn1:ISCn0 bits of the external interrupt.
+ */
+enum class PulseEdge : uint8_t {
+    ANY     = 1,
+    FALLING = 2,
+    RISING  = 3,
+};
+
+template <typename Mask, typename Flag, typename Sense0, typename Sense1> struct ExternalInterruptInfo {
+    using mask_bit   = Mask;
+    using flag_bit   = Flag;
+    using sense0_bit = Sense0;
+    using sense1_bit = Sense1;
+};
+
+template <typename T>
+concept external_interrupt_info = requires {
+    typename T::mask_bit;
+    typename T::flag_bit;
+    typename T::sense0_bit;
+    typename T::sense1_bit;
+};
+
+// INT0 is on the pin PD2, INT1 on the pin PD3
+using ExternalInterrupt0 = ExternalInterruptInfo<
+    microstd::mcu::io::INT0,
+    microstd::mcu::io::INTF0,
+    microstd::mcu::io::ISC00,
+    microstd::mcu::io::ISC01>;
+using ExternalInterrupt1 = ExternalInterruptInfo<
+    microstd::mcu::io::INT1,
+    microstd::mcu::io::INTF1,
+    microstd::mcu::io::ISC10,
+    microstd::mcu::io::ISC11>;
+
+struct pulse_data_t {
+    uint16_t count;     // edges since the previous measurement
+    uint32_t period;    // average time between the edges in microseconds (0 with less than 2 edges)
+    uint32_t frequency; // millihertz
+};
+
+using pulse_fields_t = types::fields<&pulse_data_t::count, &pulse_data_t::period, &pulse_data_t::frequency>;
+
+/**
+ * @brief Sensor counting the edges on an external interrupt pin.
+ *
+ * The interrupt handler must call `on_edge`, e.g. `SIGNAL(INT_INT0) { counter::on_edge(); }`. The handler only
+ * increments the counter and stores the clock ticks of the edge, so inputs of several kHz are counted reliably. The
+ * period and the frequency are measured between the first and the last edge of the measurement interval with the
+ * resolution of one clock tick (4 us with `timer_clock_t`).
+ *
+ * @tparam Interrupt The external interrupt (`ExternalInterrupt0`/`ExternalInterrupt1`).
+ * @tparam Info The pin of the interrupt and its pull-up.
+ * @tparam Edge The counted edge.
+ * @tparam Clock The clock of the edges, `static uint32_t Clock::ticks()` and `Clock::ticks_per_ms`.
+ */
+template <
+    external_interrupt_info Interrupt,
+    basic_sensor_info Info,
+    PulseEdge Edge = PulseEdge::RISING,
+    typename Clock = timer_clock_t>
+struct PulseCounter : types::SensorBase<pulse_data_t, types::SensorFlags::HAS_ENABLE, pulse_fields_t> {
+    static constexpr types::sensor_meta_t meta PROGMEM = { .name = "pulses" };
+
+    static constexpr types::field_meta_t fields_meta[] PROGMEM = {
+        SENSOR_FIELD(pulse_data_t, count, "", 0),
+        SENSOR_FIELD(pulse_data_t, period, "s", -6),
+        types::field_meta_t {
+            .name   = "freq",
+            .unit   = "Hz",
+            .type   = types::FieldType::U32,
+            .offset = offsetof(pulse_data_t, frequency),
+            .scale  = -3,
+        },
+    };
+
+    /**
+     * @brief Configures the pin and starts the counting.
+     */
+    static void enable() {
+        BasicSensor<Info>::enable();
+
+        if constexpr ((static_cast<uint8_t>(Edge) & 1) != 0) {
+            Interrupt::sense0_bit::set();
+        } else {
+            Interrupt::sense0_bit::unset();
+        }
+
+        if constexpr ((static_cast<uint8_t>(Edge) & 2) != 0) {
+            Interrupt::sense1_bit::set();
+        } else {
+            Interrupt::sense1_bit::unset();
+        }
+
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            edges    = 0;
+            taken_at = Clock::ticks();
+
+            // the flag of an edge from before the enable (or set by the sense change) is cleared by writing 1, only
+            // this flag is written
+            using flags_t = typename Interrupt::flag_bit::register_t;
+            flags_t::template write<typename Interrupt::flag_bit>();
+
+            Interrupt::mask_bit::set();
+        }
+    }
+
+    /**
+     * @brief Stops the counting.
+     */
+    static void disable() { Interrupt::mask_bit::unset(); }
+
+    /**
+     * @brief Counts an edge, must be called from the interrupt handler.
+     */
+    static void on_edge() {
+        const uint16_t count = edges;
+        if (count == 0xFFFF) {
+            return;
+        }
+
+        const uint32_t now = Clock::ticks();
+        if (count == 0) {
+            first_edge = now;
+        }
+
+        last_edge = now;
+        edges     = count + 1;
+    }
+
+    /**
+     * @brief Takes the edges counted since the previous measurement and restarts the counting.
+     *
+     * With at least 2 edges the frequency is measured between the first and the last edge, otherwise over the whole
+     * time since the previous measurement.
+     */
+    static optional_data_t measure() {
+        uint16_t count;
+        uint32_t span;
+        uint32_t now;
+
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            count = edges;
+            span  = last_edge - first_edge;
+            now   = Clock::ticks();
+            edges = 0;
+        }
+
+        const uint32_t elapsed = now - taken_at;
+        taken_at               = now;
+
+        pulse_data_t data = { .count = count, .period = 0, .frequency = 0 };
+
+        // 64-bit intermediate values, the ticks of a long interval times 10^6 do not fit into 32 bits
+        if (count >= 2 && span > 0) {
+            const uint32_t intervals = count - 1;
+
+            data.period    = saturate((static_cast<uint64_t>(span) * 1000) / (ticks_per_ms * intervals));
+            data.frequency = saturate((static_cast<uint64_t>(intervals) * ticks_per_ms * 1000000) / span);
+        } else if (elapsed > 0) {
+            data.frequency = saturate((static_cast<uint64_t>(count) * ticks_per_ms * 1000000) / elapsed);
+        }
+
+        return optional_data_t::some(data);
+    }
+
+private:
+    static constexpr uint32_t ticks_per_ms = Clock::ticks_per_ms;
+
+    static inline volatile uint16_t edges      = 0;
+    static inline volatile uint32_t first_edge = 0;
+    static inline volatile uint32_t last_edge  = 0;
+    static inline uint32_t taken_at            = 0;
+
+    static uint32_t saturate(uint64_t value) {
+        return (value > 0xFFFFFFFF) ? 0xFFFFFFFF : static_cast<uint32_t>(value);
+    }
+};
+
+}
+
+#endif
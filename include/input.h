@@ -0,0 +1,57 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdint.h>
+
+/**
+ * @brief Rotary encoder (DT on PD2, CLK on PD3) and its button (PD4) read by the pin change interrupt.
+ *
+ * The interrupt decodes the encoder and debounces the button, the decoded events wait in a queue until the UI takes
+ * them. So no input is lost while the main loop is blocked.
+ */
+namespace input {
+
+enum class Event : uint8_t {
+    NONE, // never queued
+    SCROLL_UP,
+    SCROLL_DOWN,
+    BUTTON, // the button was released after a press
+};
+
+/**
+ * @brief The pins of the port D read by the interrupt (DT, CLK and the button). Every change of these pins raises the
+ * interrupt, so no other driver may use them (e.g. the start signal of a DHT11 would be read as a press).
+ */
+constexpr uint8_t PORTD_PINS = (1 << 2) | (1 << 3) | (1 << 4);
+
+/**
+ * @brief Size of the event queue (a power of 2), the events which do not fit are dropped.
+ */
+constexpr uint8_t QUEUE_SIZE = 8;
+
+/**
+ * @brief Time in milliseconds for which the edges of the button are ignored after an accepted edge.
+ */
+constexpr uint8_t DEBOUNCE_MS = 20;
+
+/**
+ * @brief Configures the pins and enables the pin change interrupt.
+ */
+void init();
+
+/**
+ * @brief Checks whether an event is waiting.
+ */
+bool pending();
+
+/**
+ * @brief Takes the oldest event from the queue.
+ *
+ * @param event Reference to the variable where the event will be stored.
+ * @return false if the queue is empty.
+ */
+bool take(Event& event);
+
+}
+
+#endif
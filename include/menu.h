@@ -0,0 +1,173 @@
+#ifndef MENU_H
+#define MENU_H
+
+#include <stdint.h>
+
+/**
+ * @brief Declarative description of the UI menus.
+ *
+ * A menu is a constexpr table of items stored in the program memory (PROGMEM), the UI interprets the tables with one
+ * generic navigator. So a new menu is a new table and its strings never occupy the SRAM.
+ *
+ * @code
+ * constexpr menu::item_t MAIN_ITEMS[] PROGMEM = {
+ *     menu::link("Sensors", menu::Screen::SENSORS),
+ *     menu::number("Value:", menu::Value::INTERVAL, 1, 100),
+ *     menu::command("Exit", menu::Command::BACK),
+ * };
+ * @endcode
+ */
+namespace menu {
+
+/**
+ * @brief Maximum length of an item label (the label ends at the value of the item).
+ */
+constexpr uint8_t LABEL_SIZE = 15;
+
+/**
+ * @brief Maximum length of a choice option.
+ */
+constexpr uint8_t OPTION_SIZE = 7;
+
+/**
+ * @brief Maximum number of the items of a menu, an item takes two rows of the display.
+ */
+constexpr uint8_t MAX_ITEMS = 4;
+
+/**
+ * @brief The upper limit of a number which is replaced by the number of sensors.
+ */
+constexpr uint8_t SENSORS_LIMIT = 0;
+
+/**
+ * @brief Screens of the UI, the screens without items are drawn by the UI itself.
+ */
+enum class Screen : uint8_t {
+    DEFAULT,
+    SENSORS,
+    INTERVAL,
+    DASHBOARD,
+    GRAPH,
+    SLEEP,
+};
+
+enum class Kind : uint8_t {
+    LINK,    // opens the screen
+    COMMAND, // runs the command
+    NUMBER,  // edits the value in [min, limit)
+    CHOICE,  // edits the value as an index of the options
+    TOGGLE,  // flips the value
+};
+
+/**
+ * @brief Values which are edited by the items, the UI owns them.
+ */
+enum class Value : uint8_t {
+    INTERVAL,
+    INTERVAL_UNIT,
+    SENSOR,
+    SENSOR_ENABLED,
+    SENSOR_WATCH,
+};
+
+/**
+ * @brief Commands of the items, every command returns to the parent screen.
+ */
+enum class Command : uint8_t {
+    BACK,
+    SAVE_INTERVAL,
+    RESTORE_INTERVAL,
+};
+
+struct option_t {
+    char text[OPTION_SIZE + 1];
+};
+
+struct item_t {
+    char label[LABEL_SIZE + 1];
+    uint8_t label_length;
+    Kind kind;
+
+    // the screen, the command or the value
+    uint8_t target;
+
+    // the range of a number or the number of the options of a choice
+    uint8_t min;
+    uint8_t limit;
+    const option_t* options;
+};
+
+/**
+ * @brief Menu of a screen, the items are stored in the program memory (PROGMEM).
+ */
+struct menu_t {
+    const item_t* items;
+    uint8_t count;
+    Screen parent;
+};
+
+template <uint8_t N>
+    requires(N - 1 <= LABEL_SIZE)
+consteval item_t make_item(const char (&label)[N], Kind kind, uint8_t target) {
+    item_t item = {};
+
+    for (uint8_t i = 0; i < N; ++i) {
+        item.label[i] = label[i];
+    }
+
+    item.label_length = N - 1;
+    item.kind         = kind;
+    item.target       = target;
+
+    return item;
+}
+
+template <uint8_t N> consteval item_t link(const char (&label)[N], Screen screen) {
+    return make_item(label, Kind::LINK, static_cast<uint8_t>(screen));
+}
+
+template <uint8_t N> consteval item_t command(const char (&label)[N], Command cmd) {
+    return make_item(label, Kind::COMMAND, static_cast<uint8_t>(cmd));
+}
+
+/**
+ * @brief Number of two digits in [min, limit), the limit `SENSORS_LIMIT` is the number of sensors.
+ */
+template <uint8_t N> consteval item_t number(const char (&label)[N], Value value, uint8_t min, uint8_t limit) {
+    item_t item = make_item(label, Kind::NUMBER, static_cast<uint8_t>(value));
+    item.min    = min;
+    item.limit  = limit;
+
+    return item;
+}
+
+/**
+ * @brief Selection of an option, the options must be stored in the program memory (PROGMEM).
+ */
+template <uint8_t N, uint8_t Count>
+consteval item_t choice(const char (&label)[N], Value value, const option_t (&options)[Count]) {
+    item_t item  = make_item(label, Kind::CHOICE, static_cast<uint8_t>(value));
+    item.limit   = Count;
+    item.options = options;
+
+    return item;
+}
+
+template <uint8_t N> consteval item_t toggle(const char (&label)[N], Value value) {
+    return make_item(label, Kind::TOGGLE, static_cast<uint8_t>(value));
+}
+
+template <uint8_t Count>
+    requires(Count <= MAX_ITEMS)
+consteval menu_t make_menu(const item_t (&items)[Count], Screen parent) {
+    return menu_t { .items = items, .count = Count, .parent = parent };
+}
+
+/**
+ * @brief Menu of a screen drawn by the UI, it has only the parent.
+ */
+consteval menu_t make_screen(Screen parent) { return menu_t { .items = nullptr, .count = 0, .parent = parent }; }
+
+}
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+#ifdef KOGNITOR_TRACE
+#include <microstd/mcu/io.h>
+#endif
+
+/**
+ * @brief Markers of the hot paths for the simulator benchmarks (see `bench/sim`).
+ *
+ * With `KOGNITOR_TRACE` defined, the start and the end of a span are written to the GPIOR0 register, a single `out`
+ * instruction. The simulator timestamps the writes with the cycle counter. Without it the markers are empty.
+ */
+namespace trace {
+
+/**
+ * @brief Span ids, the simulator runner has the same table.
+ */
+enum class Span : uint8_t {
+    MEASURE   = 1, // measurement of all sensors
+    UI_UPDATE = 2, // input handling and redraw of the UI
+    COMMAND   = 3, // a command from its first byte to the response
+};
+
+/**
+ * @brief Bit of the end marker.
+ */
+constexpr uint8_t END = 0x80;
+
+#ifdef KOGNITOR_TRACE
+
+inline void begin(Span span) { microstd::mcu::io::GPIOR0::write(static_cast<uint8_t>(span)); }
+
+inline void end(Span span) { microstd::mcu::io::GPIOR0::write(static_cast<uint8_t>(span) | END); }
+
+#else
+
+inline void begin(Span) { }
+
+inline void end(Span) { }
+
+#endif
+
+}
+
+#endif
@@ -82,7 +82,7 @@ template <uint32_t Size, microstd::unsigned_type Storage = uint8_t> class bitarr
      *
      * @return The size of the bit array.
      */
-    [[nodiscard]] consteval uint8_t storage_size() const { return count; }
+    [[nodiscard]] static constexpr uint8_t storage_size() { return count; }
 
     /**
      * @brief Force write a value to the bit array.
@@ -0,0 +1,115 @@
+#ifndef TYPES_CALIBRATION_H
+#define TYPES_CALIBRATION_H
+
+#include <stdint.h>
+
+namespace types {
+
+/**
+ * @brief Calibration of a single data field: `y = (c2 * x^2 + c1 * x) / divisor + offset`.
+ *
+ * The division is replaced by a multiplication with a reciprocal precomputed when the calibration is set, so the
+ * evaluation costs only a few multiplications. The value `c2 * x^2 + c1 * x` must fit into `int32_t`. The quotient is
+ * rounded toward zero (exact while it fits into 16 bits) and the result is saturated to the range of the field type.
+ */
+struct calibration_t {
+    int16_t c2       = 0;
+    int16_t c1       = 1;
+    int16_t offset   = 0;
+    uint16_t divisor = 1;
+
+    /**
+     * @brief The reciprocal of the divisor scaled by `2^(16 + shift)` to `[2^15, 2^16)`, 0 if the divisor is 1.
+     */
+    uint16_t reciprocal = 0;
+    uint8_t shift       = 0;
+
+    /**
+     * @brief Applies the calibration. The 32-bit fields are not calibrated.
+     */
+    template <typename T> [[nodiscard]] T apply(T value) const {
+        if constexpr (sizeof(T) > sizeof(uint16_t)) {
+            return value;
+        } else {
+            const int32_t x = value;
+
+            int32_t y = static_cast<int32_t>(c1) * x;
+            if (c2 != 0) {
+                y += static_cast<int32_t>(c2) * x * x;
+            }
+
+            if (reciprocal != 0) {
+                // (|y| * reciprocal) >> (16 + shift) using two 16x16-bit multiplications
+                const bool negative      = y < 0;
+                const uint32_t magnitude = negative ? -static_cast<uint32_t>(y) : static_cast<uint32_t>(y);
+
+                const auto hi = static_cast<uint16_t>(magnitude >> 16);
+                const auto lo = static_cast<uint16_t>(magnitude);
+
+                uint32_t quotient = (static_cast<uint32_t>(hi) * reciprocal
+                                     + ((static_cast<uint32_t>(lo) * reciprocal) >> 16))
+                    >> shift;
+
+                // for 16-bit quotients the estimate is at most one less
+                if (magnitude - (quotient * divisor) >= divisor) {
+                    quotient += 1;
+                }
+
+                y = negative ? -static_cast<int32_t>(quotient) : static_cast<int32_t>(quotient);
+            }
+
+            y += offset;
+
+            constexpr bool is_signed = static_cast<T>(-1) < 0;
+            constexpr int32_t max    = is_signed ? (1L << (sizeof(T) * 8 - 1)) - 1 : (1L << (sizeof(T) * 8)) - 1;
+            constexpr int32_t min    = is_signed ? -max - 1 : 0;
+
+            if (y > max) {
+                return static_cast<T>(max);
+            }
+
+            if (y < min) {
+                return static_cast<T>(min);
+            }
+
+            return static_cast<T>(y);
+        }
+    }
+
+    /**
+     * @brief Creates the calibration and precomputes the reciprocal of the divisor.
+     *
+     * @param out Reference to the output calibration.
+     * @return false if the divisor is 0.
+     */
+    static bool make(int16_t c2, int16_t c1, int16_t offset, uint16_t divisor, calibration_t& out) {
+        if (divisor == 0) {
+            return false;
+        }
+
+        out.c2         = c2;
+        out.c1         = c1;
+        out.offset     = offset;
+        out.divisor    = divisor;
+        out.reciprocal = 0;
+        out.shift      = 0;
+
+        if (divisor == 1) {
+            return true;
+        }
+
+        // the largest shift which keeps the reciprocal in 16 bits
+        uint8_t shift = 0;
+        while (shift < 15 && ((1UL << (17 + shift)) / divisor) < (1UL << 16)) {
+            shift += 1;
+        }
+
+        out.shift      = shift;
+        out.reciprocal = static_cast<uint16_t>((1UL << (16 + shift)) / divisor);
+        return true;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef TYPES_EVENTS_H
+#define TYPES_EVENTS_H
+
+#include <microstd/types/array.h>
+
+#include <stdint.h>
+
+namespace types {
+
+/**
+ * @brief The sensor id used for events raised by the watch program.
+ */
+constexpr uint8_t PROGRAM_EVENT_SENSOR = 0xFF;
+
+/**
+ * @brief Event reported by a sensor watch.
+ */
+struct watch_event_t {
+    uint8_t rule;
+    int16_t value;
+};
+
+/**
+ * @brief Timestamped watch event.
+ */
+struct event_t {
+    uint8_t sensor;
+    uint8_t rule;
+    uint32_t timestamp;
+    int16_t value;
+};
+
+/**
+ * @brief Ring buffer of watch events. When the queue is full, the oldest event is dropped.
+ *
+ * @tparam Size The maximum number of stored events.
+ */
+template <uint8_t Size> class EventQueue {
+public:
+    static_assert(Size > 0);
+
+    /**
+     * @brief Adds an event to the queue.
+     *
+     * @param event The event.
+     */
+    void push(const event_t& event) {
+        m_events[m_head] = event;
+        m_head           = (m_head + 1) % Size;
+
+        if (m_size < Size) {
+            m_size += 1;
+        } else if (m_dropped < 0xFF) {
+            m_dropped += 1;
+        }
+    }
+
+    /**
+     * @brief Removes the oldest event from the queue.
+     *
+     * @param event Reference to the output event.
+     * @return false if the queue is empty.
+     */
+    bool pop(event_t& event) {
+        if (m_size == 0) {
+            return false;
+        }
+
+        const uint8_t tail = (m_head + Size - m_size) % Size;
+        event              = m_events[tail];
+        m_size -= 1;
+
+        return true;
+    }
+
+    [[nodiscard]] uint8_t size() const { return m_size; }
+
+    [[nodiscard]] bool empty() const { return m_size == 0; }
+
+    /**
+     * @brief Gets the number of events dropped since the last call and resets the counter.
+     */
+    uint8_t take_dropped() {
+        const uint8_t dropped = m_dropped;
+        m_dropped             = 0;
+        return dropped;
+    }
+
+private:
+    microstd::types::array_t<event_t, Size> m_events;
+    uint8_t m_head    = 0;
+    uint8_t m_size    = 0;
+    uint8_t m_dropped = 0;
+};
+
+}
+
+#endif
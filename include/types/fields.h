@@ -0,0 +1,103 @@
+#ifndef TYPES_FIELDS_H
+#define TYPES_FIELDS_H
+
+#include "types/count_to_type.h"
+
+#include <stdint.h>
+
+namespace types {
+
+template <typename T> struct member_info;
+
+template <typename Class, typename Member> struct member_info<Member Class::*> {
+    using class_t  = Class;
+    using member_t = Member;
+};
+
+/**
+ * @brief Compile-time list of the sensor data fields.
+ *
+ * The fields are serialized packed in the listed order, every field in big-endian. The serializer works with any
+ * byte sink/source, so the same layout is used for USART frames, EEPROM logs, etc.
+ *
+ * @tparam Members Pointers to the data members, e.g. `fields<&Data::x, &Data::y>`.
+ */
+template <auto... Members> struct fields {
+    static_assert(sizeof...(Members) > 0);
+
+    /**
+     * @brief The size of the serialized data in bytes.
+     */
+    static constexpr uint8_t size = (sizeof(typename member_info<decltype(Members)>::member_t) + ...);
+
+    /**
+     * @brief The number of fields.
+     */
+    static constexpr uint8_t count = sizeof...(Members);
+
+    /**
+     * @brief Serializes the data.
+     *
+     * @param data The data.
+     * @param put The byte sink, called as `put(uint8_t)`.
+     */
+    template <typename Data, typename Put> static void write(const Data& data, Put&& put) {
+        (write_value(data.*Members, put), ...);
+    }
+
+    /**
+     * @brief Deserializes the data.
+     *
+     * @param data Reference to the output data.
+     * @param get The byte source, called as `uint8_t get()`.
+     */
+    template <typename Data, typename Get> static void read(Data& data, Get&& get) {
+        (read_value(data.*Members, get), ...);
+    }
+
+    /**
+     * @brief Replaces every field with the result of the function.
+     *
+     * @param data Reference to the data.
+     * @param fn The function, called as `T fn(uint8_t field_index, T value)`.
+     */
+    template <typename Data, typename Fn> static void transform(Data& data, Fn&& fn) {
+        uint8_t i = 0;
+        ((data.*Members = fn(i++, data.*Members)), ...);
+    }
+
+    /**
+     * @brief Compares the data field by field.
+     *
+     * @param a The first data.
+     * @param b The second data.
+     * @param fn The predicate, called as `bool fn(T a, T b)`.
+     * @return true if the predicate holds for all fields.
+     */
+    template <typename Data, typename Fn> static bool compare(const Data& a, const Data& b, Fn&& fn) {
+        return (fn(a.*Members, b.*Members) && ...);
+    }
+
+private:
+    template <typename T> using unsigned_t = typename count_to_types<sizeof(T) * 8>::type;
+
+    template <typename T, typename Put> static void write_value(const T& value, Put& put) {
+        const auto raw = static_cast<unsigned_t<T>>(value);
+        for (uint8_t i = sizeof(T); i > 0; --i) {
+            put(static_cast<uint8_t>(raw >> (8 * (i - 1))));
+        }
+    }
+
+    template <typename T, typename Get> static void read_value(T& value, Get& get) {
+        unsigned_t<T> raw = 0;
+        for (uint8_t i = 0; i < sizeof(T); ++i) {
+            raw = static_cast<unsigned_t<T>>((raw << 8) | get());
+        }
+
+        value = static_cast<T>(raw);
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,198 @@
+#ifndef TYPES_FILTERS_H
+#define TYPES_FILTERS_H
+
+#include <microstd/concepts.h>
+#include <microstd/types/array.h>
+
+#include "types/fields.h"
+#include "types/sensors.h"
+
+#include <stdint.h>
+
+namespace types {
+
+/*
+ * Filter stages. Every stage provides a `state<T>` type with the method `T apply(T value)` which is called for every
+ * new sample of a single field. The stages use only integer arithmetic and static storage.
+ */
+
+/**
+ * @brief Median of the last N samples. Removes single sample outliers.
+ *
+ * @tparam N The window size.
+ */
+template <uint8_t N> struct Median {
+    static_assert(N > 0 && N <= 9 && N % 2 == 1, "The window must be odd and at most 9 samples long");
+
+    template <typename T> class state {
+    public:
+        T apply(T value) {
+            m_window[m_pos] = value;
+            m_pos           = (m_pos + 1) % N;
+
+            if (m_size < N) {
+                m_size += 1;
+            }
+
+            // insertion sort of the window copy
+            microstd::types::array_t<T, N> sorted;
+            for (uint8_t i = 0; i < m_size; ++i) {
+                const T tmp = m_window[i];
+
+                uint8_t j = i;
+                while (j > 0 && sorted[j - 1] > tmp) {
+                    sorted[j] = sorted[j - 1];
+                    j -= 1;
+                }
+
+                sorted[j] = tmp;
+            }
+
+            return sorted[m_size / 2];
+        }
+
+    private:
+        microstd::types::array_t<T, N> m_window;
+        uint8_t m_pos  = 0;
+        uint8_t m_size = 0;
+    };
+};
+
+/**
+ * @brief Exponential moving average with the smoothing factor Num/Den.
+ *
+ * The average is stored with 8 fractional bits.
+ *
+ * @tparam Num The numerator of the smoothing factor.
+ * @tparam Den The denominator of the smoothing factor, must be a power of two.
+ */
+template <uint8_t Num, uint8_t Den> struct EMA {
+    static_assert(Num > 0 && Num <= Den, "The smoothing factor must be in (0, 1]");
+    static_assert(Den <= 64 && (Den & (Den - 1)) == 0, "The denominator must be a power of two up to 64");
+
+    template <typename T> class state {
+    public:
+        static_assert(sizeof(T) <= 2, "Only 8-bit and 16-bit fields are supported");
+
+        T apply(T value) {
+            const int32_t sample = static_cast<int32_t>(value) * fraction;
+
+            if (!m_init) {
+                m_average = sample;
+                m_init    = true;
+            } else {
+                m_average += (sample - m_average) * Num / Den;
+            }
+
+            return static_cast<T>((m_average + (fraction / 2)) / fraction);
+        }
+
+    private:
+        static constexpr int32_t fraction = 256;
+
+        int32_t m_average = 0;
+        bool m_init       = false;
+    };
+};
+
+/**
+ * @brief Holds the output until the input moves more than Band away from it. Removes jitter of a steady signal.
+ *
+ * @tparam Band The dead band.
+ */
+template <uint16_t Band> struct Deadband {
+    template <typename T> class state {
+    public:
+        T apply(T value) {
+            const int32_t diff = static_cast<int32_t>(value) - static_cast<int32_t>(m_last);
+
+            if (!m_init || diff > Band || diff < -static_cast<int32_t>(Band)) {
+                m_last = value;
+                m_init = true;
+            }
+
+            return m_last;
+        }
+
+    private:
+        T m_last    = 0;
+        bool m_init = false;
+    };
+};
+
+/**
+ * @brief Chain of filter stages for a single field.
+ */
+template <typename T, typename... Stages> struct filter_chain {
+    T apply(T value) { return value; }
+};
+
+template <typename T, typename First, typename... Rest> struct filter_chain<T, First, Rest...> {
+    typename First::template state<T> first;
+    filter_chain<T, Rest...> rest;
+
+    T apply(T value) { return rest.apply(first.apply(value)); }
+};
+
+/**
+ * @brief Filter chains for every field of the data layout.
+ */
+template <typename Fields, typename... Stages> struct fields_filter;
+
+template <typename... Stages> struct fields_filter<fields<>, Stages...> {
+    template <typename Data> void apply(Data& /*unused*/) { }
+};
+
+template <auto First, auto... Rest, typename... Stages> struct fields_filter<fields<First, Rest...>, Stages...> {
+    filter_chain<typename member_info<decltype(First)>::member_t, Stages...> chain;
+    fields_filter<fields<Rest...>, Stages...> rest;
+
+    template <typename Data> void apply(Data& data) {
+        data.*First = chain.apply(data.*First);
+        rest.apply(data);
+    }
+};
+
+/**
+ * @brief Sensor whose measurements pass through the filter stages before they are cached, watched and sent.
+ *
+ * The stages are applied in the listed order to every field of the sensor data layout.
+ *
+ * @tparam Sensor The filtered sensor, it must have a data layout.
+ * @tparam Stages The filter stages, e.g. `Filtered<Sensor, Median<3>, EMA<1, 4>, Deadband<4>>`.
+ */
+template <sensor Sensor, typename... Stages>
+    requires(!microstd::same_as<typename Sensor::fields_t, void>)
+struct Filtered : Sensor {
+    using typename Sensor::optional_data_t;
+
+    static optional_data_t measure() {
+        optional_data_t opt = Sensor::measure();
+        if (!opt.has_value()) {
+            return opt;
+        }
+
+        auto data = opt.value();
+        filter.apply(data);
+
+        return optional_data_t::some(data);
+    }
+
+    static MeasureStatus poll_measure(typename Sensor::data_t& data)
+        requires sensor_has_split<Sensor>
+    {
+        const MeasureStatus status = Sensor::poll_measure(data);
+        if (status == MeasureStatus::DONE) {
+            filter.apply(data);
+        }
+
+        return status;
+    }
+
+private:
+    static inline fields_filter<typename Sensor::fields_t, Stages...> filter;
+};
+
+}
+
+#endif
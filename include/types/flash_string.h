@@ -0,0 +1,50 @@
+#ifndef TYPES_FLASH_STRING_H
+#define TYPES_FLASH_STRING_H
+
+#include "types/progmem.h"
+
+#include <stdint.h>
+
+namespace types {
+
+/**
+ * @brief Null-terminated string stored in the program memory (PROGMEM).
+ *
+ * avr-gcc copies every string literal into the SRAM at startup, the string is read from the flash instead. The type
+ * only selects the overloads which read the program memory, e.g. `com::usart::send(FSTR("OK"))`. The string has at
+ * most 255 characters.
+ */
+class flash_string {
+public:
+    /**
+     * @param str Pointer to the string stored in the program memory (PROGMEM).
+     */
+    explicit constexpr flash_string(const char* str)
+        : m_str(str) { }
+
+    /**
+     * @brief Reads the character at the index, the string ends at the character '\0'.
+     */
+    char operator[](uint8_t index) const { return static_cast<char>(progmem_read_byte(m_str + index)); }
+
+    /**
+     * @brief Pointer to the program memory, it must not be dereferenced.
+     */
+    constexpr const char* data() const { return m_str; }
+
+private:
+    const char* m_str;
+};
+
+}
+
+/**
+ * @brief Places the string literal in the program memory and returns it as `types::flash_string`.
+ */
+#define FSTR(str)                                      \
+    (::types::flash_string([] {                        \
+        static const char s_flash_str[] PROGMEM = str; \
+        return &s_flash_str[0];                        \
+    }()))
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef TYPES_FORMAT_H
+#define TYPES_FORMAT_H
+
+#include <stdint.h>
+
+#include "types/flash_string.h"
+#include "types/progmem.h"
+#include "types/sensor_meta.h"
+
+namespace types {
+
+/**
+ * @brief Text output of a fixed size, the text is truncated and always terminated.
+ */
+class text_writer_t {
+public:
+    text_writer_t(char* out, uint8_t size)
+        : m_out(out)
+        , m_size(size) {
+        if (m_size > 0) {
+            m_out[0] = '\0';
+        }
+    }
+
+    void put(char c) {
+        if (m_length + 1 < m_size) {
+            m_out[m_length]     = c;
+            m_out[m_length + 1] = '\0';
+            m_length += 1;
+        }
+    }
+
+    void put(const char* str) {
+        while (*str != '\0') {
+            put(*str);
+            str += 1;
+        }
+    }
+
+    void put(flash_string str) {
+        for (uint8_t i = 0; str[i] != '\0'; ++i) {
+            put(str[i]);
+        }
+    }
+
+    /**
+     * @brief Writes a string stored in the program memory.
+     */
+    template <uint8_t Size> void put_progmem(const char (&str)[Size]) {
+        for (uint8_t i = 0; i < Size; ++i) {
+            const char c = static_cast<char>(progmem_read_byte(&str[i]));
+            if (c == '\0') {
+                break;
+            }
+
+            put(c);
+        }
+    }
+
+    /**
+     * @brief Writes the decimal value `raw * 10^scale`, e.g. -235 with the scale -1 is "-23.5".
+     */
+    void put_decimal(int32_t raw, int8_t scale) {
+        // 10 digits of the value and the zeros before the decimal point
+        char digits[16];
+        uint8_t count = 0;
+
+        uint32_t value = (raw < 0) ? static_cast<uint32_t>(-(raw + 1)) + 1 : static_cast<uint32_t>(raw);
+        do {
+            digits[count++] = static_cast<char>('0' + (value % 10));
+            value /= 10;
+        } while (value > 0);
+
+        const uint8_t decimals = (scale < 0) ? static_cast<uint8_t>(-scale) : 0;
+        while (count <= decimals && count < sizeof(digits)) {
+            digits[count++] = '0';
+        }
+
+        if (raw < 0) {
+            put('-');
+        }
+
+        for (uint8_t i = count; i > 0; --i) {
+            if (i == decimals) {
+                put('.');
+            }
+
+            put(digits[i - 1]);
+        }
+
+        for (int8_t i = 0; i < scale; ++i) {
+            put('0');
+        }
+    }
+
+    [[nodiscard]] uint8_t length() const { return m_length; }
+
+private:
+    char* m_out;
+    uint8_t m_size;
+    uint8_t m_length = 0;
+};
+
+/**
+ * @brief Reads a field of the sensor data.
+ *
+ * @param data The sensor data.
+ * @param type The type of the field.
+ * @param offset The byte offset of the field in the data.
+ */
+inline int32_t read_field(const uint8_t* data, FieldType type, uint8_t offset) {
+    const uint8_t* bytes = data + offset;
+
+    switch (type) {
+    case FieldType::U8:
+        return bytes[0];
+    case FieldType::I8:
+        return static_cast<int8_t>(bytes[0]);
+    case FieldType::U16:
+        return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+    case FieldType::I16:
+        return static_cast<int16_t>(bytes[0] | (bytes[1] << 8));
+    case FieldType::U32:
+    case FieldType::I32:
+    default:
+        return static_cast<int32_t>(
+            static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8)
+            | (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24)
+        );
+    }
+}
+
+}
+
+#endif
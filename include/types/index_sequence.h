@@ -0,0 +1,19 @@
+#ifndef TYPES_INDEX_SEQUENCE_H
+#define TYPES_INDEX_SEQUENCE_H
+
+#include <stdint.h>
+
+namespace types {
+
+template <uint8_t... Is> struct index_sequence { };
+
+/**
+ * @brief Creates the sequence 0, 1, ..., N - 1.
+ *
+ * The sequence is generated by the compiler builtin, so it does not need N recursive instantiations.
+ */
+template <uint8_t N> using make_index_sequence = index_sequence<__integer_pack(N)...>;
+
+}
+
+#endif
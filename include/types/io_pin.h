@@ -0,0 +1,92 @@
+#ifndef TYPES_IO_PIN_H
+#define TYPES_IO_PIN_H
+
+#include <microstd/mcu/io.h>
+#include <stdint.h>
+#include <util/atomic.h>
+
+namespace types {
+
+/**
+ * @brief I/O port of the ATmega328P.
+ */
+enum class Port : uint8_t {
+    B,
+    C,
+    D,
+};
+
+/**
+ * @brief Pin selected at runtime, e.g. from a pin table in the program memory.
+ *
+ * The registers are the microstd registers of the port. The PORTx and DDRx bits of the other pins of the port may be
+ * changed by an interrupt handler (e.g. the input pins of the port D), so the bits are changed atomically.
+ */
+struct io_pin_t {
+    Port port;
+    uint8_t bit;
+
+    [[nodiscard]] bool read() const {
+        using namespace microstd::mcu::io;
+        return (read_reg<PINB, PINC, PIND>() & mask()) != 0;
+    }
+
+    void port_set() const {
+        using namespace microstd::mcu::io;
+        update<PORTB, PORTC, PORTD>(true);
+    }
+
+    void port_unset() const {
+        using namespace microstd::mcu::io;
+        update<PORTB, PORTC, PORTD>(false);
+    }
+
+    void ddr_set() const {
+        using namespace microstd::mcu::io;
+        update<DDRB, DDRC, DDRD>(true);
+    }
+
+    void ddr_unset() const {
+        using namespace microstd::mcu::io;
+        update<DDRB, DDRC, DDRD>(false);
+    }
+
+private:
+    [[nodiscard]] uint8_t mask() const { return static_cast<uint8_t>(1 << bit); }
+
+    template <typename B, typename C, typename D> [[nodiscard]] uint8_t read_reg() const {
+        switch (port) {
+        case Port::B:
+            return B::read();
+        case Port::C:
+            return C::read();
+        default:
+            return D::read();
+        }
+    }
+
+    template <typename B, typename C, typename D> void write_reg(uint8_t value) const {
+        switch (port) {
+        case Port::B:
+            B::write(value);
+            break;
+        case Port::C:
+            C::write(value);
+            break;
+        default:
+            D::write(value);
+            break;
+        }
+    }
+
+    template <typename B, typename C, typename D> void update(bool set) const {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            const uint8_t value = read_reg<B, C, D>();
+            write_reg<B, C, D>(static_cast<uint8_t>(set ? (value | mask()) : (value & ~mask())));
+        }
+    }
+};
+
+}
+
+#endif
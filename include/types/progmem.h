@@ -0,0 +1,48 @@
+#ifndef TYPES_PROGMEM_H
+#define TYPES_PROGMEM_H
+
+#include <avr/pgmspace.h>
+#include <stdint.h>
+
+namespace types {
+
+/**
+ * @brief Reads a byte from the program memory.
+ *
+ * @param ptr Pointer to the byte stored in the program memory (PROGMEM).
+ * @return The byte.
+ */
+inline uint8_t progmem_read_byte(const void* ptr) { return pgm_read_byte(ptr); }
+
+/**
+ * @brief Reads a value from the program memory.
+ *
+ * @tparam T Trivially copyable type.
+ * @param ptr Pointer to the value stored in the program memory (PROGMEM).
+ * @return The value.
+ */
+template <typename T> T progmem_read(const T* ptr) {
+    T value;
+
+    auto* out = reinterpret_cast<uint8_t*>(&value);
+
+    // the dispatch tables hold 2 byte function pointers, read by a single word load
+    if constexpr (sizeof(T) == 2) {
+        const uint16_t word = pgm_read_word(ptr);
+
+        out[0] = static_cast<uint8_t>(word);
+        out[1] = static_cast<uint8_t>(word >> 8);
+    } else {
+        const auto* in = reinterpret_cast<const uint8_t*>(ptr);
+
+        for (uint8_t i = 0; i < sizeof(T); ++i) {
+            out[i] = pgm_read_byte(in + i);
+        }
+    }
+
+    return value;
+}
+
+}
+
+#endif
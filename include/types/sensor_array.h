@@ -0,0 +1,80 @@
+#ifndef TYPES_SENSOR_ARRAY_H
+#define TYPES_SENSOR_ARRAY_H
+
+#include "types/io_pin.h"
+#include "types/progmem.h"
+#include "types/sensors.h"
+
+#include <stdint.h>
+
+namespace types {
+
+/**
+ * @brief Instance of a sensor in a sensor array.
+ */
+struct sensor_instance_t {
+    uint8_t index;
+    io_pin_t pin;
+};
+
+/**
+ * @brief Registers an instance of the sensor driver for every pin, the instances get consecutive sensor ids.
+ *
+ * All instances share the code of the driver, the pin of an instance is read from a table in the program memory. The
+ * driver derives from `SensorBase` and implements the sensor functions with `const sensor_instance_t&` as the first
+ * argument, e.g. `measure(const sensor_instance_t&)` or `watch(const sensor_instance_t&, const data_t&)`.
+ *
+ * @tparam Driver The sensor driver.
+ * @tparam Pins The pins of the instances.
+ */
+template <typename Driver, io_pin_t... Pins>
+    requires(sizeof...(Pins) > 0 && sizeof...(Pins) < 256)
+struct SensorArray : Driver {
+    using data_t          = typename Driver::data_t;
+    using optional_data_t = typename Driver::optional_data_t;
+
+    static constexpr uint8_t instances = sizeof...(Pins);
+
+    static sensor_instance_t instance(uint8_t index) {
+        return { .index = index, .pin = progmem_read(&pins[index]) };
+    }
+
+    static optional_data_t measure(uint8_t index) { return Driver::measure(instance(index)); }
+
+    static void enable(uint8_t index)
+        requires(sensors_flags_has(Driver::flags, SensorFlags::HAS_ENABLE))
+    {
+        Driver::enable(instance(index));
+    }
+
+    static void disable(uint8_t index)
+        requires(sensors_flags_has(Driver::flags, SensorFlags::HAS_ENABLE))
+    {
+        Driver::disable(instance(index));
+    }
+
+    static decltype(auto) watch(uint8_t index, const data_t& data)
+        requires(sensors_flags_has(Driver::flags, SensorFlags::HAS_WATCH))
+    {
+        return Driver::watch(instance(index), data);
+    }
+
+    static bool begin_measure(uint8_t index)
+        requires requires(const sensor_instance_t& sensor) { Driver::begin_measure(sensor); }
+    {
+        return Driver::begin_measure(instance(index));
+    }
+
+    static MeasureStatus poll_measure(uint8_t index, data_t& data)
+        requires requires(const sensor_instance_t& sensor, data_t& out) { Driver::poll_measure(sensor, out); }
+    {
+        return Driver::poll_measure(instance(index), data);
+    }
+
+private:
+    static constexpr io_pin_t pins[instances] PROGMEM = { Pins... };
+};
+
+}
+
+#endif
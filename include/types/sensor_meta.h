@@ -0,0 +1,101 @@
+#ifndef TYPES_SENSOR_META_H
+#define TYPES_SENSOR_META_H
+
+#include <microstd/concepts.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace types {
+
+/**
+ * @brief Type of a sensor data field. The values are sent over USART in big-endian.
+ */
+enum class FieldType : uint8_t {
+    U8  = 0,
+    I8  = 1,
+    U16 = 2,
+    I16 = 3,
+    U32 = 4,
+    I32 = 5,
+};
+
+template <typename T> consteval FieldType field_type_of() {
+    if constexpr (microstd::same_as<T, uint8_t>) {
+        return FieldType::U8;
+    } else if constexpr (microstd::same_as<T, int8_t>) {
+        return FieldType::I8;
+    } else if constexpr (microstd::same_as<T, uint16_t>) {
+        return FieldType::U16;
+    } else if constexpr (microstd::same_as<T, int16_t>) {
+        return FieldType::I16;
+    } else if constexpr (microstd::same_as<T, uint32_t>) {
+        return FieldType::U32;
+    } else {
+        static_assert(microstd::same_as<T, int32_t>, "Unsupported field type");
+        return FieldType::I32;
+    }
+}
+
+constexpr uint8_t field_type_size(FieldType type) {
+    switch (type) {
+    case FieldType::U8:
+    case FieldType::I8:
+        return 1;
+    case FieldType::U16:
+    case FieldType::I16:
+        return 2;
+    default:
+        return 4;
+    }
+}
+
+/**
+ * @brief Description of a single sensor data field.
+ *
+ * The real value is `raw * 10^scale` in the `unit`.
+ */
+struct field_meta_t {
+    char name[8];
+    char unit[6];
+    FieldType type;
+    uint8_t offset;
+    int8_t scale;
+};
+
+/**
+ * @brief Description of a sensor.
+ */
+struct sensor_meta_t {
+    char name[12];
+};
+
+/**
+ * @brief Sensor with metadata. Both members must be stored in the program memory (PROGMEM).
+ */
+template <typename T>
+concept sensor_has_meta = requires {
+    { T::meta } -> microstd::similar_as<sensor_meta_t>;
+    { T::fields_meta[0] } -> microstd::similar_as<field_meta_t>;
+};
+
+}
+
+/**
+ * @brief Creates the description of the sensor data field.
+ *
+ * @param DATA The sensor data type.
+ * @param MEMBER The field.
+ * @param UNIT The unit string.
+ * @param SCALE The decimal exponent of the value.
+ */
+#define SENSOR_FIELD(DATA, MEMBER, UNIT, SCALE)                     \
+    ::types::field_meta_t {                                         \
+        .name   = #MEMBER,                                          \
+        .unit   = UNIT,                                             \
+        .type   = ::types::field_type_of<decltype(DATA::MEMBER)>(), \
+        .offset = offsetof(DATA, MEMBER),                           \
+        .scale  = SCALE,                                            \
+    }
+
+#endif
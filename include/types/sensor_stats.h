@@ -0,0 +1,79 @@
+#ifndef TYPES_SENSOR_STATS_H
+#define TYPES_SENSOR_STATS_H
+
+#include <stdint.h>
+
+namespace types {
+
+/**
+ * @brief Clock of the measurement statistics when the measurements are not timed.
+ */
+struct no_clock_t {
+    static uint32_t ticks() { return 0; }
+};
+
+/**
+ * @brief Health and timing statistics of a sensor. All counters saturate.
+ *
+ * The duration is the time spent in the sensor functions during a measurement cycle, in the ticks of the clock passed
+ * to `SensorsCollection::measure_all`. The minimum and the maximum are kept for the whole run, the average decays
+ * once the number of the timed measurements saturates.
+ */
+struct sensor_stats_t {
+    uint16_t successes           = 0;
+    uint16_t failures            = 0;
+    uint8_t consecutive_failures = 0;
+
+    uint16_t min_ticks   = 0xFFFF;
+    uint16_t max_ticks   = 0;
+    uint32_t total_ticks = 0;
+    uint16_t timed       = 0;
+
+    void record(bool success) {
+        if (success) {
+            consecutive_failures = 0;
+            increment(successes);
+        } else {
+            increment(failures);
+            increment(consecutive_failures);
+        }
+    }
+
+    void record_duration(uint16_t ticks) {
+        // the halved sum keeps the average, the older durations weigh less after every halving
+        if (timed == 0xFFFF) {
+            timed >>= 1;
+            total_ticks >>= 1;
+        }
+
+        timed += 1;
+        total_ticks += ticks;
+
+        if (ticks < min_ticks) {
+            min_ticks = ticks;
+        }
+
+        if (ticks > max_ticks) {
+            max_ticks = ticks;
+        }
+    }
+
+    [[nodiscard]] uint16_t min_duration() const { return (timed == 0) ? 0 : min_ticks; }
+
+    [[nodiscard]] uint16_t avg_duration() const {
+        return (timed == 0) ? 0 : static_cast<uint16_t>(total_ticks / timed);
+    }
+
+    [[nodiscard]] uint16_t max_duration() const { return (timed == 0) ? 0 : max_ticks; }
+
+private:
+    template <typename T> static void increment(T& counter) {
+        if (counter != static_cast<T>(~static_cast<T>(0))) {
+            counter += 1;
+        }
+    }
+};
+
+}
+
+#endif
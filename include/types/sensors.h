@@ -8,16 +8,28 @@
 
 #include "com/usart.h"
 #include "types/bitarray.h"
+#include "types/calibration.h"
+#include "types/events.h"
+#include "types/fields.h"
+#include "types/format.h"
+#include "types/index_sequence.h"
 #include "types/optional.h"
+#include "types/progmem.h"
+#include "types/sensor_meta.h"
+#include "types/sensor_stats.h"
 
 #include <stdint.h>
+#include <util/delay.h>
 
 namespace types {
 
 enum class SensorFlags : uint8_t {
-    NONE       = 0,
-    HAS_ENABLE = 1 << 0,
-    HAS_WATCH  = 1 << 1,
+    NONE        = 0,
+    HAS_ENABLE  = 1 << 0,
+    HAS_WATCH   = 1 << 1,
+    HAS_DEDUP   = 1 << 2,
+    LAZY        = 1 << 3,
+    POWER_CYCLE = 1 << 4,
 };
 
 consteval SensorFlags operator|(SensorFlags a, SensorFlags b) {
@@ -34,9 +46,49 @@ concept sensor_has_enable = requires {
     { T::disable() } -> microstd::same_as<void>;
 };
 
+template <typename T>
+concept sensor_watch_reports = requires(T::data_t data) {
+    { T::watch(data) } -> microstd::similar_as<optional_t<watch_event_t>>;
+};
+
 template <typename T>
 concept sensor_has_watch = requires(T::data_t data) {
     { T::watch(data) } -> microstd::same_as<void>;
+} || sensor_watch_reports<T>;
+
+/**
+ * @brief State of a split measurement.
+ */
+enum class MeasureStatus : uint8_t {
+    PENDING = 0,
+    DONE    = 1,
+    FAILED  = 2,
+};
+
+/**
+ * @brief Sensor whose measurement is started by `begin_measure()` and finished by repeated `poll_measure()` calls, so
+ * other sensors can be measured while it waits.
+ */
+template <typename T>
+concept sensor_has_split = requires(T::data_t& data) {
+    { T::begin_measure() } -> microstd::same_as<bool>;
+    { T::poll_measure(data) } -> microstd::same_as<MeasureStatus>;
+};
+
+template <typename T>
+concept sensor_has_dedup = requires {
+    requires !microstd::same_as<typename T::fields_t, void>;
+    { T::dedup_band } -> microstd::similar_as<uint16_t>;
+};
+
+template <typename T>
+concept sensor_has_lazy = requires {
+    { T::max_age } -> microstd::similar_as<uint16_t>;
+};
+
+template <typename T>
+concept sensor_has_power_cycle = sensor_has_enable<T> && requires {
+    { T::warm_up } -> microstd::similar_as<uint16_t>;
 };
 
 template <typename T>
@@ -50,11 +102,67 @@ concept sensor = requires(T::data_t data) {
 
     requires !sensors_flags_has(T::flags, SensorFlags::HAS_ENABLE) || sensor_has_enable<T>;
     requires !sensors_flags_has(T::flags, SensorFlags::HAS_WATCH) || sensor_has_watch<T>;
+    requires !sensors_flags_has(T::flags, SensorFlags::HAS_DEDUP) || sensor_has_dedup<T>;
+    requires !sensors_flags_has(T::flags, SensorFlags::LAZY) || sensor_has_lazy<T>;
+    requires !sensors_flags_has(T::flags, SensorFlags::POWER_CYCLE) || sensor_has_power_cycle<T>;
+};
+
+template <typename T>
+concept sensor_array_watch_reports = requires(T::data_t data, uint8_t instance) {
+    { T::watch(instance, data) } -> microstd::similar_as<optional_t<watch_event_t>>;
 };
 
-template <typename Data, SensorFlags Flags = SensorFlags::NONE> struct SensorBase {
-    using data_t          = Data;
-    using optional_data_t = optional_t<data_t>;
+template <typename T>
+concept sensor_array_has_split = requires(T::data_t& data, uint8_t instance) {
+    { T::begin_measure(instance) } -> microstd::same_as<bool>;
+    { T::poll_measure(instance, data) } -> microstd::same_as<MeasureStatus>;
+};
+
+/**
+ * @brief Several instances of one sensor driver registered under consecutive sensor ids (see `SensorArray`). The
+ * sensor functions take the instance index as the first argument.
+ */
+template <typename T>
+concept sensor_array = requires(T::data_t data, uint8_t instance) {
+    typename T::data_t;
+    T::flags;
+
+    { T::instances } -> microstd::similar_as<uint8_t>;
+    { T::flags } -> microstd::similar_as<SensorFlags>;
+    { T::measure(instance) } -> microstd::similar_as<optional_t<typename T::data_t>>;
+    { T::usart_send(data) } -> microstd::same_as<void>;
+
+    requires !sensors_flags_has(T::flags, SensorFlags::HAS_ENABLE) || requires {
+        { T::enable(instance) } -> microstd::same_as<void>;
+        { T::disable(instance) } -> microstd::same_as<void>;
+    };
+    requires !sensors_flags_has(T::flags, SensorFlags::HAS_WATCH) || requires {
+        { T::watch(instance, data) } -> microstd::same_as<void>;
+    } || sensor_array_watch_reports<T>;
+    requires !sensors_flags_has(T::flags, SensorFlags::HAS_DEDUP) || sensor_has_dedup<T>;
+    requires !sensors_flags_has(T::flags, SensorFlags::LAZY) || sensor_has_lazy<T>;
+    requires !sensors_flags_has(T::flags, SensorFlags::POWER_CYCLE)
+        || (sensors_flags_has(T::flags, SensorFlags::HAS_ENABLE) && requires {
+               { T::warm_up } -> microstd::similar_as<uint16_t>;
+           });
+};
+
+template <typename T>
+concept sensor_entry = sensor<T> || sensor_array<T>;
+
+/**
+ * @brief The sensor base.
+ *
+ * @tparam Data The measured data type.
+ * @tparam Flags The sensor flags.
+ * @tparam Fields The data layout (`types::fields<...>`). If it is set, the data serializer and `usart_send` are
+ * generated from it, otherwise the sensor must implement `usart_send`.
+ */
+template <typename Data, SensorFlags Flags = SensorFlags::NONE, typename Fields = void> struct SensorBase {
+    using data_t           = Data;
+    using optional_data_t  = optional_t<data_t>;
+    using optional_watch_t = optional_t<watch_event_t>;
+    using fields_t         = Fields;
 
     static constexpr SensorFlags flags = Flags;
 
@@ -64,19 +172,74 @@ template <typename Data, SensorFlags Flags = SensorFlags::NONE> struct SensorBas
         com::usart::send(static_cast<uint8_t>(data >> 8));
         com::usart::send(data);
     }
+
+    static void usart_send(const data_t& data)
+        requires(!microstd::same_as<Fields, void>)
+    {
+        Fields::write(data, [](uint8_t byte) { com::usart::send(byte); });
+    }
+
+    /**
+     * @brief Serializes the data.
+     *
+     * @param data The data.
+     * @param put The byte sink, called as `put(uint8_t)`.
+     */
+    template <typename Put>
+        requires(!microstd::same_as<Fields, void>)
+    static void serialize(const data_t& data, Put&& put) {
+        Fields::write(data, put);
+    }
+
+    /**
+     * @brief Deserializes the data.
+     *
+     * @param get The byte source, called as `uint8_t get()`.
+     */
+    template <typename Get>
+        requires(!microstd::same_as<Fields, void>)
+    static data_t deserialize(Get&& get) {
+        data_t data;
+        Fields::read(data, get);
+        return data;
+    }
 };
 
-template <uint16_t CacheSize, sensor... Sensors>
+/**
+ * @brief Cache and dispatch of all sensors.
+ *
+ * Every sensor gets a runtime id. A sensor array takes one id per instance, the ids of its instances are consecutive
+ * and share the code of the array, only the caches and the state bits are separate.
+ */
+template <uint16_t CacheSize, sensor_entry... Sensors>
     requires(sizeof...(Sensors) < 256)
 class SensorsCollection {
 private:
     using index_t = microstd::types::conditional_t<(CacheSize < 256), uint8_t, uint16_t>;
 
-    using sensors_t                = microstd::types::tuple<Sensors...>;
-    static constexpr uint8_t count = sizeof...(Sensors);
+    using sensors_t = microstd::types::tuple<Sensors...>;
+
+    template <typename Sensor> static consteval uint8_t instances_of() {
+        if constexpr (sensor_array<Sensor>) {
+            return Sensor::instances;
+        } else {
+            return 1;
+        }
+    }
+
+    static constexpr uint8_t slots = sizeof...(Sensors);
+    static constexpr uint16_t ids  = (static_cast<uint16_t>(instances_of<Sensors>()) + ... + 0);
+    static constexpr uint8_t count = static_cast<uint8_t>(ids);
+    static_assert(ids < 256, "Too many sensor instances");
+
+    /**
+     * @brief Array with a separate part for every instance of the sensor.
+     */
+    template <typename Sensor, typename T, uint16_t Size>
+    using instances_array_t = microstd::types::array_t<microstd::types::array_t<T, Size>, instances_of<Sensor>()>;
 
     using bitarray_t     = bitarray<count, uint8_t>;
-    using sensors_data_t = microstd::types::tuple<microstd::types::array_t<typename Sensors::data_t, CacheSize>...>;
+    using sensors_data_t = microstd::types::tuple<instances_array_t<Sensors, typename Sensors::data_t, CacheSize>...>;
 
     struct data_index_t {
         index_t index = 0;
@@ -84,10 +247,75 @@ class SensorsCollection {
     };
 
     using sensors_data_indexes_t = microstd::types::array_t<data_index_t, count>;
+    using sensors_stats_t        = microstd::types::array_t<sensor_stats_t, count>;
+
+    template <typename Sensor>
+    static constexpr bool dedup_of = sensors_flags_has(Sensor::flags, SensorFlags::HAS_DEDUP);
+
+    /**
+     * @brief Number of repeats of every cached measurement, only the deduplicated sensors have a full array.
+     */
+    using sensors_repeats_t
+        = microstd::types::tuple<instances_array_t<Sensors, uint8_t, dedup_of<Sensors> ? CacheSize : 1>...>;
+
+    template <typename Sensor> static constexpr bool lazy_of = sensors_flags_has(Sensor::flags, SensorFlags::LAZY);
+
+    static constexpr uint8_t lazy_count = ((lazy_of<Sensors> ? instances_of<Sensors>() : 0) + ... + 0);
+
+    /**
+     * @brief Timestamps of the last measurement of the lazy sensors.
+     */
+    using lazy_timestamps_t = microstd::types::array_t<uint32_t, (lazy_count > 0) ? lazy_count : 1>;
+
+    template <typename Sensor>
+    static constexpr bool power_cycle_of = sensors_flags_has(Sensor::flags, SensorFlags::POWER_CYCLE);
+
+    static constexpr bool has_power_cycle = (power_cycle_of<Sensors> || ...);
+
+    template <typename Sensor>
+    static constexpr bool split_of = (sensor_has_split<Sensor> || sensor_array_has_split<Sensor>) && !lazy_of<Sensor>;
+
+    static constexpr bool has_split = (split_of<Sensors> || ...);
+
+    template <typename Sensor>
+    static constexpr bool watch_reports_of = sensor_watch_reports<Sensor> || sensor_array_watch_reports<Sensor>;
+
+    template <typename Sensor> static consteval uint8_t fields_count_of() {
+        if constexpr (microstd::same_as<typename Sensor::fields_t, void>) {
+            return 0;
+        } else {
+            return Sensor::fields_t::count;
+        }
+    }
+
+public:
+    /**
+     * @brief The number of sensor ids.
+     */
+    static constexpr uint8_t sensors_count = count;
+
+    /**
+     * @brief The number of the cached measurements of every sensor.
+     */
+    static constexpr uint16_t cache_size = CacheSize;
+
+    /**
+     * @brief The SRAM of one cached measurement of every sensor, i.e. the cost of incrementing `CacheSize`.
+     */
+    static constexpr uint16_t sample_size
+        = (((sizeof(typename Sensors::data_t) + (dedup_of<Sensors> ? 1 : 0)) * instances_of<Sensors>()) + ... + 0);
+
+    /**
+     * @brief The number of calibrated fields of all sensors.
+     */
+    static constexpr uint8_t calibrations_count = ((fields_count_of<Sensors>() * instances_of<Sensors>()) + ... + 0);
+
+private:
+    using calibrations_t = microstd::types::array_t<calibration_t, (calibrations_count > 0) ? calibrations_count : 1>;
 
 public:
     template <uint8_t I>
-        requires(I < count)
+        requires(I < slots)
     using sensor_get_t = microstd::types::tuple_element_t<I, sensors_t>;
 
     [[nodiscard]] bool is_enabled(uint8_t i) const { return m_enabled.get(i); }
@@ -98,27 +326,34 @@ class SensorsCollection {
 
         m_enabled.clear_all();
         m_watch_enabled.clear_all();
+        m_powered.clear_all();
+        m_pending.clear_all();
+        m_attempted.clear_all();
 
         enable_all();
     }
 
     void enable(uint8_t i) {
-        set_state<0, true>(i);
+        dispatch(dispatch_t::enable, i)(*this, i);
         m_enabled.set(i);
     }
 
     void disable(uint8_t i) {
-        set_state<0, false>(i);
+        dispatch(dispatch_t::disable, i)(*this, i);
         m_enabled.clear(i);
     }
 
     void enable_all() {
-        set_state_all<0, true>();
+        for (uint8_t i = 0; i < count; ++i) {
+            dispatch(dispatch_t::enable, i)(*this, i);
+        }
         m_enabled.set_all();
     }
 
     void disable_all() {
-        set_state_all<0, false>();
+        for (uint8_t i = 0; i < count; ++i) {
+            dispatch(dispatch_t::disable, i)(*this, i);
+        }
         m_enabled.clear_all();
     }
 
@@ -134,147 +369,1013 @@ class SensorsCollection {
 
     [[nodiscard]] uint8_t enabled_watch(uint8_t chunk_index) const { return m_watch_enabled.get_raw(chunk_index); }
 
-    [[nodiscard]] consteval uint8_t chunks_count() const { return m_enabled.storage_size(); }
+    [[nodiscard]] static constexpr uint8_t chunks_count() { return bitarray_t::count; }
+
+    void usart_send(uint8_t i) const { dispatch(dispatch_t::send, i)(*this, i); }
 
-    void usart_send(uint8_t i) const { usart_send_impl(i); }
+    /**
+     * @brief Gets a cached measurement.
+     *
+     * @tparam I The sensor index in the template arguments.
+     * @param age How many measurements back to go (0 is the latest). Must be less than `samples<I>()`.
+     * @param instance The instance of a sensor array.
+     */
+    template <uint8_t I>
+        requires(I < slots)
+    decltype(auto) measure(index_t age = 0, uint8_t instance = 0) const {
+        return tuple_get<I>(m_data)[instance][slot(base_of<I>() + instance, age)];
+    }
 
+    /**
+     * @brief Gets the number of cached measurements. For the deduplicated sensors the repeated measurements are
+     * counted once.
+     */
     template <uint8_t I>
-        requires(I < count)
-    decltype(auto) measure() const {
-        index_t index = m_indexes[I].index;
+        requires(I < slots)
+    [[nodiscard]] index_t samples(uint8_t instance = 0) const {
+        return m_indexes[base_of<I>() + instance].size;
+    }
 
-        if (index == 0) {
-            index = CacheSize - 1;
+    /**
+     * @brief Gets how many times a cached measurement was repeated after it was stored (0 if the sensor is not
+     * deduplicated).
+     *
+     * @tparam I The sensor index in the template arguments.
+     * @param age How many measurements back to go (0 is the latest). Must be less than `samples<I>()`.
+     * @param instance The instance of a sensor array.
+     */
+    template <uint8_t I>
+        requires(I < slots)
+    [[nodiscard]] uint8_t repeats(index_t age = 0, uint8_t instance = 0) const {
+        if constexpr (dedup_of<sensor_get_t<I>>) {
+            return tuple_get<I>(m_repeats)[instance][slot(base_of<I>() + instance, age)];
         } else {
-            index = index - 1;
+            return 0;
+        }
+    }
+
+    /**
+     * @brief Copies raw bytes of a cached measurement.
+     *
+     * @param i The sensor index.
+     * @param age How many measurements back to go (0 is the latest).
+     * @param offset The byte offset in the sensor data.
+     * @param size The number of bytes to copy.
+     * @param out The output buffer.
+     * @return false if the sensor, the measurement or the bytes do not exist.
+     */
+    bool read_raw(uint8_t i, index_t age, uint8_t offset, uint8_t size, uint8_t* out) const {
+        return dispatch(dispatch_t::read_raw, i)(*this, i, age, offset, size, out);
+    }
+
+    /**
+     * @brief Sends all cached measurements from the oldest, the repeated measurements are sent repeatedly.
+     *
+     * @param i The sensor index.
+     */
+    void usart_send_all(uint8_t i) const { dispatch(dispatch_t::send_all, i)(*this, i); }
+
+    /**
+     * @brief Sends all cached measurements from the oldest, every measurement is preceded by its repeat count.
+     *
+     * @param i The sensor index.
+     */
+    void usart_send_rle(uint8_t i) const { dispatch(dispatch_t::send_rle, i)(*this, i); }
+
+    /**
+     * @brief Sends the sensor metadata.
+     *
+     * @param i The sensor index.
+     */
+    static void usart_send_meta(uint8_t i) { dispatch(dispatch_t::send_meta, i)(); }
+
+    /**
+     * @brief Writes the sensor name from the metadata, the instances of a sensor array are numbered. The sensors
+     * without the metadata are written as "#<id>".
+     *
+     * @param i The sensor index.
+     * @param out The output text.
+     */
+    static void format_name(uint8_t i, text_writer_t& out) { dispatch(dispatch_t::format_name, i)(i, out); }
+
+    /**
+     * @brief Writes the fields of the latest measurement with their units (e.g. "23.5C 41%") using the metadata. The
+     * sensors without the metadata are written as "?" and the sensors without a measurement as "--".
+     *
+     * @param i The sensor index.
+     * @param out The output text.
+     */
+    void format_latest(uint8_t i, text_writer_t& out) const { dispatch(dispatch_t::format_latest, i)(*this, i, out); }
+
+    /**
+     * @brief Gets the number of the fields described by the sensor metadata (0 without the metadata).
+     */
+    static uint8_t meta_fields(uint8_t i) { return progmem_read_byte(&dispatch_t::meta_fields[i]); }
+
+    /**
+     * @brief Writes the name of the field from the metadata.
+     *
+     * @param i The sensor index.
+     * @param field The field, must be less than `meta_fields(i)`.
+     * @param out The output text.
+     */
+    static void format_field_name(uint8_t i, uint8_t field, text_writer_t& out) {
+        out.put_progmem(field_meta(i, field)->name);
+    }
+
+    /**
+     * @brief Writes a value of the field with its scale and unit, e.g. "23.5C".
+     *
+     * @param i The sensor index.
+     * @param field The field, must be less than `meta_fields(i)`.
+     * @param value The raw value (see `read_field`).
+     * @param out The output text.
+     */
+    static void format_field(uint8_t i, uint8_t field, int32_t value, text_writer_t& out) {
+        const field_meta_t* meta = field_meta(i, field);
+
+        out.put_decimal(value, static_cast<int8_t>(progmem_read_byte(&meta->scale)));
+        out.put_progmem(meta->unit);
+    }
+
+    /**
+     * @brief Reads the raw value of a field of a cached measurement.
+     *
+     * @param i The sensor index.
+     * @param field The field described by the metadata.
+     * @param age How many measurements back to go (0 is the latest).
+     * @param value Reference to the output value.
+     * @return false if the measurement does not exist or the field is not described.
+     */
+    bool read_field(uint8_t i, uint8_t field, index_t age, int32_t& value) const {
+        if (field >= meta_fields(i)) {
+            return false;
+        }
+
+        const field_meta_t* meta = field_meta(i, field);
+        const auto type          = static_cast<FieldType>(progmem_read_byte(&meta->type));
+
+        uint8_t bytes[4];
+        if (!read_raw(i, age, progmem_read_byte(&meta->offset), field_type_size(type), bytes)) {
+            return false;
+        }
+
+        value = types::read_field(bytes, type, 0);
+        return true;
+    }
+
+    /**
+     * @brief Gets the number of cached measurements of the sensor.
+     */
+    [[nodiscard]] index_t samples_count(uint8_t i) const { return m_indexes[i].size; }
+
+    /**
+     * @brief Gets the cache slot of the next measurement, it moves by one with every stored measurement.
+     */
+    [[nodiscard]] index_t sample_position(uint8_t i) const { return m_indexes[i].index; }
+
+    /**
+     * @brief Measures a single sensor if it is enabled.
+     *
+     * @param i The sensor index.
+     * @param event Reference to the event reported by the sensor watch.
+     * @return true if the watch reported an event.
+     */
+    bool measure_single(uint8_t i, event_t& event) { return dispatch(dispatch_t::measure, i)(*this, i, event); }
+
+    /**
+     * @brief Measures all enabled sensors except the lazy ones.
+     *
+     * The sensors with the split interface are started first and polled between the other measurements, so their
+     * waiting overlaps with the other sensors.
+     *
+     * @tparam Clock The clock of the measurement durations, `static uint32_t Clock::ticks()`. The durations are not
+     * measured with `no_clock_t`.
+     * @param events The queue for the events reported by the sensor watches.
+     * @param timestamp The timestamp of the events.
+     */
+    template <typename Clock = no_clock_t, typename Queue> void measure_all(Queue& events, uint32_t timestamp) {
+        durations_t durations;
+        for (uint8_t i = 0; i < count; ++i) {
+            durations[i] = 0;
         }
 
-        return tuple_get<I>(m_data)[index];
+        m_attempted.clear_all();
+
+        if constexpr (has_split) {
+            for (uint8_t i = 0; i < count; ++i) {
+                timed<Clock>(durations[i], [this, i] { dispatch(dispatch_t::begin, i)(*this, i); });
+            }
+        }
+
+        for (uint8_t i = 0; i < count; ++i) {
+            poll_pending<Clock>(events, timestamp, durations);
+
+            event_t event;
+            bool reported = false;
+            timed<Clock>(durations[i], [&] { reported = dispatch(dispatch_t::measure_periodic, i)(*this, i, event); });
+
+            if (reported) {
+                event.timestamp = timestamp;
+                events.push(event);
+            }
+        }
+
+        while (poll_pending<Clock>(events, timestamp, durations)) { }
+
+        if constexpr (!microstd::same_as<Clock, no_clock_t>) {
+            for (uint8_t i = 0; i < count; ++i) {
+                if (m_attempted.get(i)) {
+                    m_stats[i].record_duration(durations[i]);
+                }
+            }
+        }
     }
 
-    void usart_send_all(uint8_t i) const { usart_send_impl<0, true>(i); }
+    /**
+     * @brief Powers up the power cycled sensors whose warm-up ends before the next measurement.
+     *
+     * Every sensor is powered up its warm-up time ahead of the measurement, so the warm-up windows of all sensors
+     * overlap and end at the measurement.
+     *
+     * @param remaining The time until the next measurement in milliseconds.
+     */
+    void power_up(uint32_t remaining) {
+        if constexpr (has_power_cycle) {
+            for (uint8_t i = 0; i < count; ++i) {
+                dispatch(dispatch_t::power_up, i)(*this, i, remaining);
+            }
+        }
+    }
 
-    void measure_all() { measure_all_impl(); }
+    /**
+     * @brief Powers down all power cycled sensors after the measurement.
+     */
+    void power_down() {
+        if constexpr (has_power_cycle) {
+            for (uint8_t i = 0; i < count; ++i) {
+                dispatch(dispatch_t::power_down, i)(*this, i);
+            }
+        }
+    }
+
+    /**
+     * @brief Measures a lazy sensor if it is enabled and its latest measurement is older than its max age. Other
+     * sensors are not measured.
+     *
+     * The call waits for a single measurement, which is bounded by the sensor driver. If the measurement fails, the
+     * cache is kept.
+     *
+     * @param i The sensor index.
+     * @param events The queue for the events reported by the sensor watch.
+     * @param timestamp The current time in seconds.
+     */
+    template <typename Queue> void refresh(uint8_t i, Queue& events, uint32_t timestamp) {
+        event_t event;
+        if (dispatch(dispatch_t::refresh, i)(*this, i, event, timestamp)) {
+            event.timestamp = timestamp;
+            events.push(event);
+        }
+    }
+
+    /**
+     * @brief Sets the calibration of a sensor field.
+     *
+     * @param i The sensor index.
+     * @param field The field index in the data layout.
+     * @param calibration The calibration.
+     * @return false if the sensor or the field does not exist.
+     */
+    bool set_calibration(uint8_t i, uint8_t field, const calibration_t& calibration) {
+        if (i >= count) {
+            return false;
+        }
+
+        uint8_t index = 0;
+        for (uint8_t s = 0; s < i; ++s) {
+            index += progmem_read_byte(&dispatch_t::fields[s]);
+        }
+
+        if (field >= progmem_read_byte(&dispatch_t::fields[i])) {
+            return false;
+        }
+
+        m_calibrations[index + field] = calibration;
+        return true;
+    }
+
+    /**
+     * @brief Gets the health and timing statistics of a sensor.
+     *
+     * @param i The sensor index.
+     */
+    [[nodiscard]] const sensor_stats_t& stats(uint8_t i) const { return m_stats[i]; }
+
+    /**
+     * @brief Gets the calibration of a field. The fields of all sensors are numbered in the order of the sensor ids.
+     *
+     * @param index The field index, must be less than `calibrations_count`.
+     */
+    [[nodiscard]] const calibration_t& calibration(uint8_t index) const { return m_calibrations[index]; }
+
+    void force_write_calibration(uint8_t index, const calibration_t& calibration) {
+        m_calibrations[index] = calibration;
+    }
 
     void force_write_enable(uint8_t chunk_index, uint8_t value) { m_enabled.force_write(chunk_index, value); }
 
     void force_write_watch(uint8_t chunk_index, uint8_t value) { m_watch_enabled.force_write(chunk_index, value); }
 
-    [[nodiscard]] consteval uint8_t size() const { return count; }
+    [[nodiscard]] static constexpr uint8_t size() { return count; }
 
 private:
     bitarray_t m_enabled;
     bitarray_t m_watch_enabled;
     sensors_data_t m_data;
     sensors_data_indexes_t m_indexes;
+    sensors_repeats_t m_repeats;
+    calibrations_t m_calibrations;
+    lazy_timestamps_t m_measured_at;
+    bitarray_t m_powered;
+    bitarray_t m_pending;
+    bitarray_t m_attempted;
+    sensors_stats_t m_stats;
+
+    using durations_t = microstd::types::array_t<uint16_t, count>;
+
+    static constexpr uint8_t slot_instances[slots] = { instances_of<Sensors>()... };
+
+    static constexpr uint8_t slot_fields[slots] = { fields_count_of<Sensors>()... };
+
+    static constexpr bool lazy_sensors[slots] = { lazy_of<Sensors>... };
+
+    /**
+     * @brief Gets the index in the template arguments of the sensor with the id.
+     */
+    static consteval uint8_t slot_of(uint8_t id) {
+        uint8_t s = 0;
+        while (id >= slot_instances[s]) {
+            id -= slot_instances[s];
+            s += 1;
+        }
 
-    template <uint8_t I = 0> void measure_all_impl() {
-        if (is_enabled(I)) {
-            using sensor_t                         = sensor_get_t<I>;
-            typename sensor_t::optional_data_t opt = sensor_t::measure();
+        return s;
+    }
 
-            if (opt.has_value()) {
-                auto value = opt.value();
+    /**
+     * @brief Gets the id of the first instance of the sensor.
+     */
+    template <uint8_t I> static consteval uint8_t base_of() {
+        uint8_t id = 0;
+        for (uint8_t s = 0; s < I; ++s) {
+            id += slot_instances[s];
+        }
 
-                if constexpr (sensors_flags_has(sensor_t::flags, SensorFlags::HAS_WATCH)) {
-                    if (is_enabled_watch(I)) {
-                        sensor_t::watch(value);
-                    }
-                }
+        return id;
+    }
 
-                data_index_t index = m_indexes[I];
+    /**
+     * @brief Gets the instance of a sensor array from the sensor id, 0 for the other sensors.
+     */
+    template <uint8_t I> static uint8_t instance_of(uint8_t id) {
+        if constexpr (sensor_array<sensor_get_t<I>>) {
+            return id - base_of<I>();
+        } else {
+            return 0;
+        }
+    }
 
-                tuple_get<I>(m_data)[index.index] = value;
+    template <uint8_t I> static consteval uint8_t lazy_offset() {
+        uint8_t offset = 0;
+        for (uint8_t s = 0; s < I; ++s) {
+            offset += lazy_sensors[s] ? slot_instances[s] : 0;
+        }
+
+        return offset;
+    }
 
-                if (index.size < CacheSize) {
-                    index.size += 1;
+    template <uint8_t I> static consteval uint8_t calibration_offset() {
+        uint8_t offset = 0;
+        for (uint8_t s = 0; s < I; ++s) {
+            offset += slot_fields[s] * slot_instances[s];
+        }
+
+        return offset;
+    }
+
+    /**
+     * @brief Gets the cache slot of a measurement.
+     *
+     * @param id The sensor id.
+     * @param age How many measurements back to go (0 is the latest).
+     */
+    [[nodiscard]] index_t slot(uint8_t id, index_t age) const {
+        const index_t index = m_indexes[id].index;
+
+        if (index > age) {
+            return index - age - 1;
+        }
+
+        return CacheSize - 1 - (age - index);
+    }
+
+    /**
+     * @brief Calls the function for every cached measurement from the oldest.
+     *
+     * @param fn The function, called as `fn(const data_t&, uint8_t repeats)`.
+     */
+    template <uint8_t I, typename Fn> void for_each_sample(uint8_t id, Fn&& fn) const {
+        const uint8_t instance   = instance_of<I>(id);
+        const data_index_t index = m_indexes[id];
+        auto& data               = tuple_get<I>(m_data)[instance];
+
+        index_t i = (index.size < CacheSize) ? 0 : index.index;
+        for (index_t n = 0; n < index.size; ++n) {
+            if constexpr (dedup_of<sensor_get_t<I>>) {
+                fn(data[i], tuple_get<I>(m_repeats)[instance][i]);
+            } else {
+                fn(data[i], static_cast<uint8_t>(0));
+            }
+
+            i = (i + 1) % CacheSize;
+        }
+    }
+
+    /**
+     * @brief Counts the measurement as a repeat of the latest cached measurement if all fields are within the
+     * deadband of the sensor.
+     *
+     * @return true if the measurement was counted as a repeat.
+     */
+    template <uint8_t I> bool dedup(uint8_t id, const typename sensor_get_t<I>::data_t& value) {
+        using sensor_t = sensor_get_t<I>;
+
+        if (m_indexes[id].size == 0) {
+            return false;
+        }
+
+        const uint8_t instance = instance_of<I>(id);
+        const index_t last     = slot(id, 0);
+        uint8_t& repeats       = tuple_get<I>(m_repeats)[instance][last];
+
+        const bool within = sensor_t::fields_t::compare(
+            tuple_get<I>(m_data)[instance][last], value,
+            [](auto a, auto b) { return within_band(a, b, sensor_t::dedup_band); }
+        );
+
+        if (!within || repeats == 0xFF) {
+            return false;
+        }
+
+        repeats += 1;
+        return true;
+    }
+
+    template <typename T> static bool within_band(T a, T b, uint16_t band) {
+        using unsigned_t = typename count_to_types<sizeof(T) * 8>::type;
+
+        const auto diff = (a > b) ? static_cast<unsigned_t>(static_cast<unsigned_t>(a) - static_cast<unsigned_t>(b))
+                                  : static_cast<unsigned_t>(static_cast<unsigned_t>(b) - static_cast<unsigned_t>(a));
+        return diff <= band;
+    }
+
+    /*
+     * Calls of the sensor functions, the sensor arrays get the instance as the first argument.
+     */
+
+    template <uint8_t I> static auto sensor_measure([[maybe_unused]] uint8_t instance) {
+        if constexpr (sensor_array<sensor_get_t<I>>) {
+            return sensor_get_t<I>::measure(instance);
+        } else {
+            return sensor_get_t<I>::measure();
+        }
+    }
+
+    template <uint8_t I> static void sensor_enable([[maybe_unused]] uint8_t instance) {
+        if constexpr (sensor_array<sensor_get_t<I>>) {
+            sensor_get_t<I>::enable(instance);
+        } else {
+            sensor_get_t<I>::enable();
+        }
+    }
+
+    template <uint8_t I> static void sensor_disable([[maybe_unused]] uint8_t instance) {
+        if constexpr (sensor_array<sensor_get_t<I>>) {
+            sensor_get_t<I>::disable(instance);
+        } else {
+            sensor_get_t<I>::disable();
+        }
+    }
+
+    template <uint8_t I>
+    static decltype(auto) sensor_watch(
+        [[maybe_unused]] uint8_t instance, const typename sensor_get_t<I>::data_t& data
+    ) {
+        if constexpr (sensor_array<sensor_get_t<I>>) {
+            return sensor_get_t<I>::watch(instance, data);
+        } else {
+            return sensor_get_t<I>::watch(data);
+        }
+    }
+
+    template <uint8_t I> static bool sensor_begin([[maybe_unused]] uint8_t instance) {
+        if constexpr (sensor_array<sensor_get_t<I>>) {
+            return sensor_get_t<I>::begin_measure(instance);
+        } else {
+            return sensor_get_t<I>::begin_measure();
+        }
+    }
+
+    template <uint8_t I>
+    static MeasureStatus sensor_poll([[maybe_unused]] uint8_t instance, typename sensor_get_t<I>::data_t& data) {
+        if constexpr (sensor_array<sensor_get_t<I>>) {
+            return sensor_get_t<I>::poll_measure(instance, data);
+        } else {
+            return sensor_get_t<I>::poll_measure(data);
+        }
+    }
+
+    template <uint8_t I> static bool measure_at(SensorsCollection& self, uint8_t id, event_t& event) {
+        if (!self.is_enabled(id)) {
+            return false;
+        }
+
+        const typename sensor_get_t<I>::optional_data_t opt = sensor_measure<I>(instance_of<I>(id));
+
+        self.record(id, opt.has_value());
+        if (!opt.has_value()) {
+            return false;
+        }
+
+        return store_at<I>(self, id, opt.value(), event);
+    }
+
+    /**
+     * @brief Polls all started split measurements once.
+     *
+     * @return true if a measurement is still pending.
+     */
+    template <typename Clock, typename Queue>
+    bool poll_pending(Queue& events, uint32_t timestamp, [[maybe_unused]] durations_t& durations) {
+        if constexpr (has_split) {
+            bool pending = false;
+
+            for (uint8_t i = 0; i < count; ++i) {
+                if (!m_pending.get(i)) {
+                    continue;
                 }
 
-                index.index = (index.index + 1) % CacheSize;
+                event_t event;
+                bool reported = false;
+                timed<Clock>(durations[i], [&] { reported = dispatch(dispatch_t::poll, i)(*this, i, event); });
 
-                m_indexes[I] = index;
+                if (reported) {
+                    event.timestamp = timestamp;
+                    events.push(event);
+                }
+
+                pending = pending || m_pending.get(i);
             }
+
+            return pending;
+        } else {
+            return false;
         }
+    }
 
-        if constexpr (I + 1 < count) {
-            measure_all_impl<I + 1>();
+    /**
+     * @brief Calls the function and adds its duration in the clock ticks to the sensor duration (saturated).
+     */
+    template <typename Clock, typename Fn> static void timed(uint16_t& duration, Fn&& fn) {
+        if constexpr (microstd::same_as<Clock, no_clock_t>) {
+            fn();
+        } else {
+            const uint32_t start = Clock::ticks();
+            fn();
+            const uint32_t sum = duration + (Clock::ticks() - start);
+
+            duration = (sum > 0xFFFF) ? 0xFFFF : static_cast<uint16_t>(sum);
         }
     }
 
-    template <uint8_t I = 0, bool all = false> void usart_send_impl(uint8_t i) const {
+    /**
+     * @brief Counts the result of a measurement in the sensor statistics.
+     */
+    void record(uint8_t id, bool success) {
+        m_attempted.set(id);
+        m_stats[id].record(success);
+    }
+
+    template <uint8_t I> static void begin_at(SensorsCollection& self, uint8_t id) {
         using sensor_t = sensor_get_t<I>;
 
-        if (I == i) {
-            if constexpr (all) {
-                send_all<I>();
+        if constexpr (split_of<sensor_t>) {
+            if (!self.is_enabled(id)) {
+                return;
+            }
+
+            if constexpr (power_cycle_of<sensor_t>) {
+                if (!self.m_powered.get(id)) {
+                    warm_up_at<I>(self, id);
+                }
+            }
 
+            if (sensor_begin<I>(instance_of<I>(id))) {
+                self.m_pending.set(id);
             } else {
-                sensor_t::usart_send(measure<I>());
+                self.record(id, false);
+            }
+        }
+    }
+
+    template <uint8_t I> static bool poll_at(SensorsCollection& self, uint8_t id, event_t& event) {
+        using sensor_t = sensor_get_t<I>;
+
+        if constexpr (split_of<sensor_t>) {
+            typename sensor_t::data_t data;
+
+            switch (sensor_poll<I>(instance_of<I>(id), data)) {
+            case MeasureStatus::PENDING:
+                return false;
+            case MeasureStatus::DONE:
+                self.m_pending.clear(id);
+                self.record(id, true);
+                return store_at<I>(self, id, data, event);
+            case MeasureStatus::FAILED:
+                break;
             }
-        } else if constexpr (I + 1 < count) {
-            usart_send_impl<I + 1>(i);
+
+            self.m_pending.clear(id);
+            self.record(id, false);
         }
+
+        return false;
     }
 
-    template <uint8_t I = 0, bool enable = true>
-        requires(I < count)
-    void set_state(uint8_t i) {
-        if (I == i) {
-            set_state<I, enable>();
-        } else if constexpr (I + 1 < count) {
-            set_state<I + 1, enable>(i);
+    template <uint8_t I> static bool measure_periodic_at(SensorsCollection& self, uint8_t id, event_t& event) {
+        if constexpr (lazy_of<sensor_get_t<I>> || split_of<sensor_get_t<I>>) {
+            return false;
+        } else {
+            if constexpr (power_cycle_of<sensor_get_t<I>>) {
+                // the sensor was enabled or the interval changed too late for the scheduled warm-up
+                if (self.is_enabled(id) && !self.m_powered.get(id)) {
+                    warm_up_at<I>(self, id);
+                }
+            }
+
+            return measure_at<I>(self, id, event);
         }
     }
 
-    template <uint8_t I = 0, bool enable = true>
-        requires(I < count)
-    void set_state_all() {
-        set_state<I, enable>();
-        if constexpr (I + 1 < count) {
-            set_state<I, enable>();
+    /**
+     * @brief Powers up the sensor and waits for its warm-up.
+     */
+    template <uint8_t I> static void warm_up_at(SensorsCollection& self, uint8_t id) {
+        sensor_enable<I>(instance_of<I>(id));
+        self.m_powered.set(id);
+
+        _delay_ms(sensor_get_t<I>::warm_up);
+    }
+
+    template <uint8_t I> static void power_up_at(SensorsCollection& self, uint8_t id, uint32_t remaining) {
+        using sensor_t = sensor_get_t<I>;
+
+        if constexpr (power_cycle_of<sensor_t> && !lazy_of<sensor_t>) {
+            if (remaining <= sensor_t::warm_up && self.is_enabled(id) && !self.m_powered.get(id)) {
+                sensor_enable<I>(instance_of<I>(id));
+                self.m_powered.set(id);
+            }
         }
     }
 
-    template <uint8_t I = 0, bool enable = true>
-        requires(I < count)
-    void set_state() {
+    template <uint8_t I> static void power_down_at(SensorsCollection& self, uint8_t id) {
+        if constexpr (power_cycle_of<sensor_get_t<I>>) {
+            if (self.m_powered.get(id)) {
+                sensor_disable<I>(instance_of<I>(id));
+                self.m_powered.clear(id);
+            }
+        }
+    }
+
+    template <uint8_t I>
+    static bool refresh_at(SensorsCollection& self, uint8_t id, event_t& event, uint32_t timestamp) {
         using sensor_t = sensor_get_t<I>;
-        if constexpr (sensors_flags_has(sensor_t::flags, SensorFlags::HAS_ENABLE)) {
-            const bool state = is_enabled(I);
+
+        if constexpr (lazy_of<sensor_t>) {
+            const uint8_t instance = instance_of<I>(id);
+            uint32_t& measured_at  = self.m_measured_at[lazy_offset<I>() + instance];
+
+            if (!self.is_enabled(id) || (self.m_indexes[id].size > 0 && timestamp - measured_at < sensor_t::max_age)) {
+                return false;
+            }
+
+            if constexpr (power_cycle_of<sensor_t>) {
+                warm_up_at<I>(self, id);
+            }
+
+            const typename sensor_t::optional_data_t opt = sensor_measure<I>(instance);
+
+            if constexpr (power_cycle_of<sensor_t>) {
+                power_down_at<I>(self, id);
+            }
+
+            self.record(id, opt.has_value());
+            if (!opt.has_value()) {
+                return false;
+            }
+
+            measured_at = timestamp;
+            return store_at<I>(self, id, opt.value(), event);
+        } else {
+            return false;
+        }
+    }
+
+    /**
+     * @brief Calibrates, watches and caches a new measurement.
+     *
+     * @return true if the watch reported an event.
+     */
+    template <uint8_t I>
+    static bool store_at(SensorsCollection& self, uint8_t id, typename sensor_get_t<I>::data_t value, event_t& event) {
+        using sensor_t = sensor_get_t<I>;
+
+        const uint8_t instance = instance_of<I>(id);
+        bool reported          = false;
+
+        if constexpr (fields_count_of<sensor_t>() > 0) {
+            const calibration_t* calibrations
+                = &self.m_calibrations[calibration_offset<I>() + (instance * fields_count_of<sensor_t>())];
+            sensor_t::fields_t::transform(
+                value, [calibrations](uint8_t field, auto x) { return calibrations[field].apply(x); }
+            );
+        }
+
+        // a repeated measurement does not take a cache slot and it is not watched
+        if constexpr (dedup_of<sensor_t>) {
+            if (self.dedup<I>(id, value)) {
+                return false;
+            }
+        }
+
+        if constexpr (sensors_flags_has(sensor_t::flags, SensorFlags::HAS_WATCH)) {
+            if (self.is_enabled_watch(id)) {
+                if constexpr (watch_reports_of<sensor_t>) {
+                    const optional_t<watch_event_t> watch_event = sensor_watch<I>(instance, value);
+                    if (watch_event.has_value()) {
+                        event.sensor = id;
+                        event.rule   = watch_event.value().rule;
+                        event.value  = watch_event.value().value;
+                        reported     = true;
+                    }
+                } else {
+                    sensor_watch<I>(instance, value);
+                }
+            }
+        }
+
+        data_index_t index = self.m_indexes[id];
+
+        tuple_get<I>(self.m_data)[instance][index.index] = value;
+
+        if constexpr (dedup_of<sensor_t>) {
+            tuple_get<I>(self.m_repeats)[instance][index.index] = 0;
+        }
+
+        if (index.size < CacheSize) {
+            index.size += 1;
+        }
+
+        index.index = (index.index + 1) % CacheSize;
+
+        self.m_indexes[id] = index;
+        return reported;
+    }
+
+    template <uint8_t I>
+    static bool read_raw_at(
+        const SensorsCollection& self, uint8_t id, index_t age, uint8_t offset, uint8_t size, uint8_t* out
+    ) {
+        if (age >= self.m_indexes[id].size || offset + size > sizeof(typename sensor_get_t<I>::data_t)) {
+            return false;
+        }
+
+        const auto& data  = tuple_get<I>(self.m_data)[instance_of<I>(id)][self.slot(id, age)];
+        const auto* bytes = reinterpret_cast<const uint8_t*>(&data);
+        for (uint8_t b = 0; b < size; ++b) {
+            out[b] = bytes[offset + b];
+        }
+
+        return true;
+    }
+
+    template <uint8_t I> static void send_at(const SensorsCollection& self, uint8_t id) {
+        sensor_get_t<I>::usart_send(tuple_get<I>(self.m_data)[instance_of<I>(id)][self.slot(id, 0)]);
+    }
+
+    template <uint8_t I, bool enable> static void set_state(SensorsCollection& self, uint8_t id) {
+        using sensor_t = sensor_get_t<I>;
+        if constexpr (power_cycle_of<sensor_t>) {
+            // the power is managed by the measurement schedule
+            if constexpr (!enable) {
+                power_down_at<I>(self, id);
+            }
+        } else if constexpr (sensors_flags_has(sensor_t::flags, SensorFlags::HAS_ENABLE)) {
+            const bool state = self.is_enabled(id);
             if constexpr (enable) {
                 if (!state) {
-                    sensor_t::enable();
+                    sensor_enable<I>(instance_of<I>(id));
                 }
             } else {
                 if (state) {
-                    sensor_t::disable();
+                    sensor_disable<I>(instance_of<I>(id));
                 }
             }
         }
     }
 
-    template <uint8_t I>
-        requires(I < count)
-    void send_all() const {
+    template <uint8_t I> static void send_all_at(const SensorsCollection& self, uint8_t id) {
+        self.for_each_sample<I>(id, [](const auto& data, uint8_t repeats) {
+            for (uint16_t n = 0; n <= repeats; ++n) {
+                sensor_get_t<I>::usart_send(data);
+            }
+        });
+    }
 
+    template <uint8_t I> static void send_rle_at(const SensorsCollection& self, uint8_t id) {
+        self.for_each_sample<I>(id, [](const auto& data, uint8_t repeats) {
+            com::usart::send(repeats);
+            sensor_get_t<I>::usart_send(data);
+        });
+    }
+
+    template <uint8_t I> static void send_meta_at() {
         using sensor_t = sensor_get_t<I>;
 
-        const data_index_t index = m_indexes[I];
-        auto& data               = tuple_get<I>(m_data);
+        if constexpr (sensor_has_meta<sensor_t>) {
+            constexpr uint8_t field_count = sizeof(sensor_t::fields_meta) / sizeof(field_meta_t);
+            if constexpr (!microstd::same_as<typename sensor_t::fields_t, void>) {
+                static_assert(field_count == sensor_t::fields_t::count, "The metadata does not match the data layout");
+            }
+
+            send_meta_string(sensor_t::meta.name);
+            com::usart::send(static_cast<uint8_t>(sensor_t::flags));
+            com::usart::send(field_count);
 
-        if (index.size < CacheSize) {
-            for (index_t i = 0; i < index.size; ++i) {
-                sensor_t::usart_send(data[i]);
+            for (uint8_t i = 0; i < field_count; ++i) {
+                const field_meta_t& field = sensor_t::fields_meta[i];
+
+                send_meta_string(field.name);
+                send_meta_string(field.unit);
+                com::usart::send(progmem_read_byte(&field.type));
+                com::usart::send(progmem_read_byte(&field.offset));
+                com::usart::send(progmem_read_byte(&field.scale));
             }
         } else {
-            index_t i = index.index;
-            for (index_t tmp = 0; tmp < index.size; ++tmp) {
-                sensor_t::usart_send(data[i]);
+            com::usart::send('\0');
+            com::usart::send(static_cast<uint8_t>(sensor_t::flags));
+            com::usart::send(static_cast<uint8_t>(0));
+        }
+    }
 
-                i = (i + 1) % CacheSize;
+    template <uint8_t I> static consteval uint8_t meta_fields_of() {
+        if constexpr (sensor_has_meta<sensor_get_t<I>>) {
+            return sizeof(sensor_get_t<I>::fields_meta) / sizeof(field_meta_t);
+        } else {
+            return 0;
+        }
+    }
+
+    template <uint8_t I> static consteval const field_meta_t* fields_meta_of() {
+        if constexpr (sensor_has_meta<sensor_get_t<I>>) {
+            return sensor_get_t<I>::fields_meta;
+        } else {
+            return nullptr;
+        }
+    }
+
+    static const field_meta_t* field_meta(uint8_t i, uint8_t field) {
+        return dispatch(dispatch_t::fields_meta, i) + field;
+    }
+
+    template <uint8_t I> static void format_name_at(uint8_t id, text_writer_t& out) {
+        using sensor_t = sensor_get_t<I>;
+
+        if constexpr (sensor_has_meta<sensor_t>) {
+            out.put_progmem(sensor_t::meta.name);
+
+            // the instances of an array are numbered ("dht11#1"), an array of one pin keeps the plain name
+            if constexpr (sensor_array<sensor_t>) {
+                if constexpr (sensor_t::instances > 1) {
+                    out.put('#');
+                    out.put_decimal(instance_of<I>(id), 0);
+                }
+            }
+        } else {
+            out.put('#');
+            out.put_decimal(id, 0);
+        }
+    }
+
+    template <uint8_t I> static void format_latest_at(const SensorsCollection& self, uint8_t id, text_writer_t& out) {
+        using sensor_t = sensor_get_t<I>;
+
+        if constexpr (sensor_has_meta<sensor_t>) {
+            if (self.m_indexes[id].size == 0) {
+                out.put(FSTR("--"));
+                return;
+            }
+
+            constexpr uint8_t field_count = sizeof(sensor_t::fields_meta) / sizeof(field_meta_t);
+
+            const auto& data  = tuple_get<I>(self.m_data)[instance_of<I>(id)][self.slot(id, 0)];
+            const auto* bytes = reinterpret_cast<const uint8_t*>(&data);
+
+            for (uint8_t i = 0; i < field_count; ++i) {
+                const field_meta_t& field = sensor_t::fields_meta[i];
+
+                if (i > 0) {
+                    out.put(' ');
+                }
+
+                const auto type   = static_cast<FieldType>(progmem_read_byte(&field.type));
+                const auto offset = progmem_read_byte(&field.offset);
+                const auto scale  = static_cast<int8_t>(progmem_read_byte(&field.scale));
+
+                out.put_decimal(types::read_field(bytes, type, offset), scale);
+                out.put_progmem(field.unit);
+            }
+        } else {
+            out.put('?');
+        }
+    }
+
+    /**
+     * @brief Sends a string stored in the program memory including the null terminator.
+     */
+    template <uint8_t Size> static void send_meta_string(const char (&str)[Size]) {
+        for (uint8_t i = 0; i < Size; ++i) {
+            const uint8_t c = progmem_read_byte(&str[i]);
+            if (c == '\0') {
+                break;
             }
+
+            com::usart::send(c);
         }
+
+        com::usart::send('\0');
     }
+
+    using meta_fn_t     = void (*)();
+    using const_fn_t    = void (*)(const SensorsCollection&, uint8_t);
+    using state_fn_t    = void (*)(SensorsCollection&, uint8_t);
+    using measure_fn_t  = bool (*)(SensorsCollection&, uint8_t, event_t&);
+    using refresh_fn_t  = bool (*)(SensorsCollection&, uint8_t, event_t&, uint32_t);
+    using power_fn_t    = void (*)(SensorsCollection&, uint8_t, uint32_t);
+    using read_raw_fn_t = bool (*)(const SensorsCollection&, uint8_t, index_t, uint8_t, uint8_t, uint8_t*);
+    using name_fn_t     = void (*)(uint8_t, text_writer_t&);
+    using format_fn_t   = void (*)(const SensorsCollection&, uint8_t, text_writer_t&);
+
+    /**
+     * @brief Per sensor jump tables stored in the program memory.
+     *
+     * A runtime sensor id is turned into a call of the sensor specific function with a single table lookup instead of
+     * comparing the id with every sensor. All instances of a sensor array point to the same function.
+     */
+    template <typename Seq> struct dispatch_tables;
+
+    template <uint8_t... Is> struct dispatch_tables<index_sequence<Is...>> {
+        static constexpr const_fn_t send[count] PROGMEM               = { &send_at<slot_of(Is)>... };
+        static constexpr const_fn_t send_all[count] PROGMEM           = { &send_all_at<slot_of(Is)>... };
+        static constexpr const_fn_t send_rle[count] PROGMEM           = { &send_rle_at<slot_of(Is)>... };
+        static constexpr state_fn_t enable[count] PROGMEM             = { &set_state<slot_of(Is), true>... };
+        static constexpr state_fn_t disable[count] PROGMEM            = { &set_state<slot_of(Is), false>... };
+        static constexpr measure_fn_t measure[count] PROGMEM          = { &measure_at<slot_of(Is)>... };
+        static constexpr measure_fn_t measure_periodic[count] PROGMEM = { &measure_periodic_at<slot_of(Is)>... };
+        static constexpr refresh_fn_t refresh[count] PROGMEM          = { &refresh_at<slot_of(Is)>... };
+        static constexpr read_raw_fn_t read_raw[count] PROGMEM        = { &read_raw_at<slot_of(Is)>... };
+        static constexpr meta_fn_t send_meta[count] PROGMEM           = { &send_meta_at<slot_of(Is)>... };
+        static constexpr power_fn_t power_up[count] PROGMEM           = { &power_up_at<slot_of(Is)>... };
+        static constexpr state_fn_t power_down[count] PROGMEM         = { &power_down_at<slot_of(Is)>... };
+        static constexpr state_fn_t begin[count] PROGMEM              = { &begin_at<slot_of(Is)>... };
+        static constexpr measure_fn_t poll[count] PROGMEM             = { &poll_at<slot_of(Is)>... };
+        static constexpr name_fn_t format_name[count] PROGMEM         = { &format_name_at<slot_of(Is)>... };
+        static constexpr format_fn_t format_latest[count] PROGMEM     = { &format_latest_at<slot_of(Is)>... };
+
+        static constexpr uint8_t fields[count] PROGMEM                   = { slot_fields[slot_of(Is)]... };
+        static constexpr uint8_t meta_fields[count] PROGMEM              = { meta_fields_of<slot_of(Is)>()... };
+        static constexpr const field_meta_t* fields_meta[count] PROGMEM = { fields_meta_of<slot_of(Is)>()... };
+    };
+
+    using dispatch_t = dispatch_tables<make_index_sequence<count>>;
+
+    /**
+     * @brief Loads the function for the sensor from the jump table.
+     *
+     * @param table The jump table.
+     * @param i The sensor index.
+     */
+    template <typename Fn> static Fn dispatch(const Fn* table, uint8_t i) { return progmem_read(&table[i]); }
 };
 
 }
@@ -4,108 +4,154 @@
 #include <microstd/int_types.h>
 #include <microstd/types/conditional.h>
 
-struct AppAdapter {
-    void* ctx;
-    void (*set_interval)(void*, microstd::uint32_t);
-    bool (*is_enabled)(void*, microstd::uint8_t);
-    bool (*is_watched)(void*, microstd::uint8_t);
-
-    void (*set_watch)(void*, microstd::uint8_t, bool);
-    void (*set_enable)(void*, microstd::uint8_t, bool);
-};
-
-class UI {
+#include "clock.h"
+#include "component/display/ssd1306.h"
+#include "input.h"
+#include "menu.h"
+#include "types/flash_string.h"
+#include "types/format.h"
+
+/**
+ * @brief The part of the UI which does not access the sensors: the menus, the input and the display output.
+ */
+class UIBase {
 public:
-    void init(microstd::uint32_t interval, AppAdapter adapter, microstd::uint8_t sensors_count);
-    void update();
     void update_interval(microstd::uint32_t interval);
 
-    void request_update() { request_update(UPDATE_MANUAL); }
+    void request_update() { m_update |= UPDATE_MANUAL; }
 
-private:
-    static constexpr microstd::uint8_t UPDATE_NONE   = 0;
-    static constexpr microstd::uint8_t UPDATE_SCROLL = 1;
-    static constexpr microstd::uint8_t UPDATE_BUTTON = 2;
-    static constexpr microstd::uint8_t UPDATE_MANUAL = 4;
+    /**
+     * @brief Notifies the UI about new measurements, the dashboard and the graph show them within their display traffic
+     * budget.
+     */
+    void samples_updated() { m_samples_updated = true; }
 
-    void request_update(microstd::uint8_t type) { m_update |= type; }
+    /**
+     * @brief Gets the duration of the last redraw in the timer ticks (see `timer_clock_t`).
+     */
+    [[nodiscard]] microstd::uint16_t redraw_ticks() const { return m_redraw_ticks; }
 
-    using item_t  = microstd::uint8_t;
-    using value_t = microstd::uint8_t;
+    /**
+     * @brief Gets the longest redraw in the timer ticks.
+     */
+    [[nodiscard]] microstd::uint16_t redraw_max_ticks() const { return m_redraw_max_ticks; }
 
-    enum Menu {
-        Default,
-        Sensors,
-        Interval,
-        Sleep,
-    };
+protected:
+    static constexpr microstd::uint8_t UPDATE_NONE   = 0;
+    static constexpr microstd::uint8_t UPDATE_MANUAL = 1;
 
-    enum class DefaultMenu {
-        Sensors,
-        Interval,
-        Sleep,
-        Len,
-    };
+    static constexpr microstd::uint8_t DASHBOARD_ROWS       = component::display::SSD1306::pages;
+    static constexpr microstd::uint8_t DASHBOARD_NAME_WIDTH = 7;
+    static constexpr microstd::uint8_t DASHBOARD_VALUE_X    = DASHBOARD_NAME_WIDTH + 2;
+    static constexpr char INDICATOR_SYMBOL                  = '*';
 
-    enum class IntervalMenu {
-        IntervalUnit,
-        IntervalValue,
-        Restore,
-        Save,
-        Len,
-    };
+    static constexpr microstd::uint8_t GRAPH_WIDTH  = component::display::SSD1306::width;
+    static constexpr microstd::uint8_t GRAPH_HEIGHT = component::display::SSD1306::graph_height;
 
-    enum class SensorsMenu {
-        Sensor,
-        SensorEnabled,
-        SensorWatch,
-        Exit,
-        Len,
-    };
+    static constexpr char EXIT_TEXT[] PROGMEM      = "Exit";
+    static constexpr char OFF_TEXT[] PROGMEM       = "off";
+    static constexpr char NO_FIELDS_TEXT[] PROGMEM = "No fields";
+
+    using item_t  = microstd::uint8_t;
+    using value_t = microstd::uint8_t;
 
     enum IntervalUnit : value_t {
         Seconds,
         Minutes,
         Hours,
-        Len,
     };
 
-    enum class BtnState : bool {
-        Down,
-        Up,
+    /**
+     * @brief Everything shown on the display, the difference of two views is redrawn.
+     */
+    struct view_t {
+        menu::Screen menu;
+        item_t item;
+        bool value_input;
+
+        // the values of the menu items
+        value_t values[menu::MAX_ITEMS];
+
+        value_t dashboard_item;
+        value_t dashboard_first;
+        value_t graph_field;
     };
 
-    void default_menu();
-    void sensors_menu();
-    void interval_menu();
+    /**
+     * @brief Initializes the input and the display.
+     *
+     * @param delay The measurement interval in seconds, the saved interval is written to it.
+     * @param sensors_count The number of sensors.
+     */
+    void init(microstd::uint32_t& delay, microstd::uint8_t sensors_count);
+
+    /**
+     * @brief Sends the pending display changes and checks whether the UI has to be updated.
+     */
+    [[nodiscard]] bool begin_update();
+
+    /**
+     * @brief Clears the display when the screen of the view changed.
+     *
+     * @return true if the whole screen has to be drawn.
+     */
+    [[nodiscard]] bool begin_repaint(const view_t& view);
+
+    void end_update(microstd::uint32_t start);
+
+    [[nodiscard]] static menu::menu_t read_menu(menu::Screen screen);
+    [[nodiscard]] static menu::item_t read_item(const menu::menu_t& menu, item_t i);
+
+    /**
+     * @brief Handles the event in a menu of items.
+     *
+     * @param menu The menu of the current screen.
+     * @param toggled The value of the pressed toggle item.
+     * @return true if a toggle item was pressed, the caller flips the value.
+     */
+    [[nodiscard]] bool navigate(const menu::menu_t& menu, menu::Value& toggled);
+
+    void open(menu::Screen screen);
+    void back();
+    void run_command(menu::Command command);
+    void dashboard_menu();
     void sleep_menu();
 
-    void draw_menu();
-    void draw_interval_menu();
-    void draw_sensors_menu();
+    [[nodiscard]] value_t* edited_value(menu::Value value);
+    [[nodiscard]] value_t item_limit(const menu::item_t& item) const;
+
+    /**
+     * @brief Gets the value of an item which does not access the sensors (the toggles are 0).
+     */
+    [[nodiscard]] value_t item_value(const menu::item_t& item) const;
 
-    void init_counter();
-    void update_counter();
+    [[nodiscard]] bool refresh_due();
 
-    void reset_counter() { m_counter = 0; }
+    [[nodiscard]] microstd::uint8_t graph_y(microstd::int32_t value) const;
 
-    [[nodiscard]] char counter() const { return m_counter; }
+    void draw_items(const menu::menu_t& menu);
+    void draw_item_changes(const menu::menu_t& menu, const view_t& view);
+    void draw_item_value(item_t row, const menu::item_t& item, const view_t& view);
+
+    static component::display::SSD1306& display();
+    static void display_spaces(microstd::uint8_t count);
+    static void display_text(const char* text, microstd::uint8_t width);
+    static void display_text(types::flash_string text, microstd::uint8_t width);
 
     void update_menu_item(item_t length);
 
     void update_value(value_t& value, value_t min, value_t max) const;
 
-    bool btn_pressed();
+    [[nodiscard]] bool btn_pressed() const { return m_event == input::Event::BUTTON; }
 
     microstd::uint8_t m_update = UPDATE_MANUAL;
     bool m_value_input         = false;
     item_t m_menu_item         = 0;
 
-    Menu m_menu = Menu::Default;
+    menu::Screen m_menu = menu::Screen::DEFAULT;
 
-    char m_counter      = 0;
-    char m_prev_counter = 0;
-    bool m_counter_clk  = false;
+    // the handled input event, NONE for the requested updates
+    input::Event m_event = input::Event::NONE;
 
     // interval
     value_t m_interval;
@@ -114,20 +160,377 @@ class UI {
     value_t m_interval_real;
     value_t m_interval_unit_real;
 
+    microstd::uint32_t* m_delay = nullptr;
+
     // sensor
     value_t m_sensor_id = 0;
     microstd::uint8_t m_sensor_count;
 
-    BtnState m_btn_state      = BtnState::Up;
-    BtnState m_btn_state_prev = BtnState::Up;
+    // dashboard, the item after the sensors is the exit
+    value_t m_dashboard_item  = 0;
+    value_t m_dashboard_first = 0;
+    bool m_samples_updated    = false;
+    bool m_refresh            = false;
+
+    // graph of a field of the selected sensor, the range is updated incrementally with every new measurement
+    value_t m_graph_field               = 0;
+    bool m_graph_valid                  = false;
+    microstd::uint8_t m_graph_count     = 0;
+    microstd::uint16_t m_graph_position = 0;
+    microstd::int32_t m_graph_min       = 0;
+    microstd::int32_t m_graph_max       = 0;
+    microstd::int32_t m_graph_oldest    = 0;
+
+    // display traffic budget of the dashboard and graph refreshes in bytes
+    microstd::int32_t m_budget         = 0;
+    microstd::uint32_t m_budget_at     = 0;
+    microstd::uint16_t m_budget_queued = 0;
+
+    // drawn view
+    view_t m_view;
+    bool m_drawn = false;
+
+    microstd::uint16_t m_redraw_ticks     = 0;
+    microstd::uint16_t m_redraw_max_ticks = 0;
+};
+
+/**
+ * @brief UI bound to the sensors collection of the app.
+ *
+ * The sensors are accessed by direct calls, so the menu actions compile to the bit operations of the collection
+ * instead of the calls through function pointers.
+ *
+ * @tparam Sensors The `SensorsCollection` of the app.
+ */
+template <typename Sensors> class UI : public UIBase {
+public:
+    /**
+     * @brief Initializes the UI.
+     *
+     * @param sensors The sensors shown and changed by the UI.
+     * @param delay The measurement interval in seconds, the saved interval is written to it.
+     */
+    void init(Sensors& sensors, microstd::uint32_t& delay);
+
+    void update();
+
+private:
+    void update_menu();
+    void graph_menu();
+    void toggle(menu::Value value);
+
+    void update_graph_range(microstd::uint8_t id, microstd::uint8_t field);
 
-    microstd::uint8_t m_btn_counter = 0;
+    [[nodiscard]] view_t current_view() const;
 
-    AppAdapter m_adapter;
+    void draw_menu();
+    void draw_changes(const view_t& view);
+    void draw_dashboard(const view_t& view);
+    void draw_graph(const view_t& view);
+
+    Sensors* m_sensors = nullptr;
 };
 
 class EmptyUI { };
 
-template <bool Enable> using ui_type = microstd::types::conditional_t<Enable, UI, EmptyUI>;
+template <bool Enable, typename Sensors> using ui_type = microstd::types::conditional_t<Enable, UI<Sensors>, EmptyUI>;
+
+template <typename Sensors> inline void UI<Sensors>::init(Sensors& sensors, microstd::uint32_t& delay) {
+    UIBase::init(delay, Sensors::sensors_count);
+
+    m_sensors = &sensors;
+}
+
+template <typename Sensors> inline void UI<Sensors>::update() {
+    if (!begin_update()) {
+        return;
+    }
+
+    const microstd::uint32_t start = timer_clock_t::ticks();
+
+    if (m_update != UPDATE_NONE) {
+        m_event = input::Event::NONE;
+        update_menu();
+    }
+
+    // every queued event moves the menu, the display shows only the result
+    while (input::take(m_event)) {
+        update_menu();
+    }
+
+    m_event = input::Event::NONE;
+
+    const view_t view = current_view();
+
+    // only the menu transitions repaint the whole display
+    if (begin_repaint(view)) {
+        draw_menu();
+    } else {
+        draw_changes(view);
+        m_view = view;
+    }
+
+    end_update(start);
+}
+
+template <typename Sensors> inline void UI<Sensors>::update_menu() {
+    const menu::menu_t menu = read_menu(m_menu);
+    if (menu.count > 0) {
+        menu::Value toggled;
+        if (navigate(menu, toggled)) {
+            toggle(toggled);
+        }
+        return;
+    }
+
+    switch (m_menu) {
+    case menu::Screen::DASHBOARD:
+        dashboard_menu();
+        break;
+    case menu::Screen::GRAPH:
+        graph_menu();
+        break;
+    case menu::Screen::SLEEP:
+        sleep_menu();
+        break;
+    default:
+        break;
+    }
+}
+
+template <typename Sensors> inline void UI<Sensors>::graph_menu() {
+    const value_t fields = Sensors::meta_fields(m_dashboard_item);
+    if (fields > 1) {
+        const value_t field = m_graph_field;
+        update_value(m_graph_field, 0, fields);
+
+        m_graph_valid = m_graph_valid && field == m_graph_field;
+    }
+
+    if (btn_pressed()) {
+        back();
+    }
+}
+
+template <typename Sensors> inline void UI<Sensors>::toggle(menu::Value value) {
+    if (value == menu::Value::SENSOR_ENABLED) {
+        if (m_sensors->is_enabled(m_sensor_id)) {
+            m_sensors->disable(m_sensor_id);
+        } else {
+            m_sensors->enable(m_sensor_id);
+        }
+    } else if (value == menu::Value::SENSOR_WATCH) {
+        if (m_sensors->is_enabled_watch(m_sensor_id)) {
+            m_sensors->disable_watch(m_sensor_id);
+        } else {
+            m_sensors->enable_watch(m_sensor_id);
+        }
+    }
+}
+
+template <typename Sensors>
+inline void UI<Sensors>::update_graph_range(microstd::uint8_t id, microstd::uint8_t field) {
+    const microstd::uint16_t samples  = m_sensors->samples_count(id);
+    const microstd::uint16_t position = m_sensors->sample_position(id);
+    const microstd::uint8_t count     = (samples < GRAPH_WIDTH) ? samples : GRAPH_WIDTH;
+
+    const microstd::uint16_t added = (position + Sensors::cache_size - m_graph_position) % Sensors::cache_size;
+
+    microstd::int32_t value;
+    bool rescan = !m_graph_valid || m_graph_count == 0 || added > 1;
+
+    if (!rescan && added == 1 && m_sensors->read_field(id, field, 0, value)) {
+        // the oldest point left the graph, only a lost extreme needs the whole range again
+        const bool evicted = count == m_graph_count;
+        if (evicted && (m_graph_oldest == m_graph_min || m_graph_oldest == m_graph_max)) {
+            rescan = true;
+        } else {
+            m_graph_min = (value < m_graph_min) ? value : m_graph_min;
+            m_graph_max = (value > m_graph_max) ? value : m_graph_max;
+        }
+    }
+
+    if (rescan) {
+        m_graph_min = 0x7FFFFFFF;
+        m_graph_max = -m_graph_min - 1;
+
+        for (microstd::uint8_t age = 0; age < count; ++age) {
+            if (m_sensors->read_field(id, field, age, value)) {
+                m_graph_min = (value < m_graph_min) ? value : m_graph_min;
+                m_graph_max = (value > m_graph_max) ? value : m_graph_max;
+            }
+        }
+    }
+
+    if (count > 0) {
+        m_sensors->read_field(id, field, count - 1, m_graph_oldest);
+    }
+
+    m_graph_count    = count;
+    m_graph_position = position;
+    m_graph_valid    = true;
+}
+
+template <typename Sensors> inline UIBase::view_t UI<Sensors>::current_view() const {
+    view_t view = {
+        .menu            = m_menu,
+        .item            = m_menu_item,
+        .value_input     = m_value_input,
+        .values          = {},
+        .dashboard_item  = m_dashboard_item,
+        .dashboard_first = m_dashboard_first,
+        .graph_field     = m_graph_field,
+    };
+
+    const menu::menu_t menu = read_menu(m_menu);
+    for (item_t i = 0; i < menu.count; ++i) {
+        const menu::item_t item = read_item(menu, i);
+        const auto value        = static_cast<menu::Value>(item.target);
+
+        // the toggles show the bits of the selected sensor
+        if (item.kind != menu::Kind::TOGGLE) {
+            view.values[i] = item_value(item);
+        } else if (value == menu::Value::SENSOR_ENABLED) {
+            view.values[i] = m_sensors->is_enabled(m_sensor_id);
+        } else if (value == menu::Value::SENSOR_WATCH) {
+            view.values[i] = m_sensors->is_enabled_watch(m_sensor_id);
+        }
+    }
+
+    return view;
+}
+
+template <typename Sensors> inline void UI<Sensors>::draw_menu() {
+    const menu::menu_t menu = read_menu(m_menu);
+    if (menu.count > 0) {
+        draw_items(menu);
+        return;
+    }
+
+    switch (m_menu) {
+    case menu::Screen::DASHBOARD:
+        draw_dashboard(m_view);
+        break;
+    case menu::Screen::GRAPH:
+        draw_graph(m_view);
+        break;
+    case menu::Screen::SLEEP:
+        display().sleep(true);
+        break;
+    default:
+        break;
+    }
+}
+
+template <typename Sensors> inline void UI<Sensors>::draw_changes(const view_t& view) {
+    const menu::menu_t menu = read_menu(view.menu);
+    if (menu.count > 0) {
+        draw_item_changes(menu, view);
+        return;
+    }
+
+    switch (view.menu) {
+    case menu::Screen::DASHBOARD:
+        // the display sends only the changed characters
+        if (view.dashboard_item != m_view.dashboard_item || m_refresh) {
+            draw_dashboard(view);
+        }
+        break;
+    case menu::Screen::GRAPH:
+        // the display sends only the changed columns
+        if (view.graph_field != m_view.graph_field || m_refresh) {
+            draw_graph(view);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+template <typename Sensors> inline void UI<Sensors>::draw_dashboard(const view_t& view) {
+    constexpr microstd::uint8_t columns = component::display::SSD1306::columns;
+
+    char text[columns + 1];
+
+    for (microstd::uint8_t row = 0; row < DASHBOARD_ROWS; ++row) {
+        const microstd::uint8_t id = view.dashboard_first + row;
+
+        display().goto_xy(0, row);
+        display().putc((id == view.dashboard_item) ? INDICATOR_SYMBOL : ' ');
+
+        if (id == Sensors::sensors_count) {
+            display_text(types::flash_string(EXIT_TEXT), columns - 1);
+            continue;
+        }
+
+        if (id > Sensors::sensors_count) {
+            display_spaces(columns - 1);
+            continue;
+        }
+
+        types::text_writer_t name(text, DASHBOARD_NAME_WIDTH + 1);
+        Sensors::format_name(id, name);
+        display_text(text, DASHBOARD_VALUE_X - 1);
+
+        types::text_writer_t value(text, columns - DASHBOARD_VALUE_X + 1);
+        if (m_sensors->is_enabled(id)) {
+            m_sensors->format_latest(id, value);
+        } else {
+            value.put_progmem(OFF_TEXT);
+        }
+        display_text(text, columns - DASHBOARD_VALUE_X);
+    }
+
+    m_samples_updated = false;
+}
+
+template <typename Sensors> inline void UI<Sensors>::draw_graph(const view_t& view) {
+    constexpr microstd::uint8_t columns = component::display::SSD1306::columns;
+
+    const microstd::uint8_t id = view.dashboard_item;
+
+    char text[columns + 1];
+    types::text_writer_t title(text, sizeof(text));
+    Sensors::format_name(id, title);
+
+    m_samples_updated = false;
+
+    if (Sensors::meta_fields(id) == 0) {
+        display().goto_xy(0, 0);
+        display_text(text, columns);
+
+        display().goto_xy(0, 2);
+        display().puts(types::flash_string(NO_FIELDS_TEXT));
+        return;
+    }
+
+    update_graph_range(id, view.graph_field);
+
+    microstd::int32_t value;
+
+    title.put(' ');
+    Sensors::format_field_name(id, view.graph_field, title);
+    if (m_sensors->read_field(id, view.graph_field, 0, value)) {
+        title.put(' ');
+        Sensors::format_field(id, view.graph_field, value, title);
+    }
+
+    display().goto_xy(0, 0);
+    display_text(text, columns);
+
+    display().graph(true);
+
+    // the latest measurement is in the last column
+    for (microstd::uint8_t x = 0; x < GRAPH_WIDTH; ++x) {
+        const microstd::uint8_t age = GRAPH_WIDTH - 1 - x;
+
+        microstd::uint8_t y = component::display::SSD1306::no_point;
+        if (age < m_graph_count && m_sensors->read_field(id, view.graph_field, age, value)) {
+            y = graph_y(value);
+        }
+
+        display().plot(x, y);
+    }
+}
 
 #endif
@@ -0,0 +1,130 @@
+#ifndef VM_VM_H
+#define VM_VM_H
+
+#include <microstd/types/array.h>
+
+#include <stdint.h>
+
+namespace vm {
+
+/**
+ * @brief Instruction set of the watch/filter machine.
+ *
+ * Every instruction is a single opcode byte followed by its immediate operands. Values are signed 16-bit integers.
+ * Jumps are relative and can only go forward, so every verified program terminates after at most one pass.
+ */
+enum class Op : uint8_t {
+    HALT = 0x00, // stop, the result is the top of the stack (0 if the stack is empty)
+
+    PUSH8  = 0x01, // [imm8] push a sign-extended byte
+    PUSH16 = 0x02, // [hi, lo] push a 16-bit value
+
+    LOAD_U8  = 0x03, // [sensor, age, offset] push an unsigned byte of a cached sample
+    LOAD_I8  = 0x04, // [sensor, age, offset] push a signed byte of a cached sample
+    LOAD_I16 = 0x05, // [sensor, age, offset] push a 16-bit value of a cached sample
+
+    DUP  = 0x06,
+    DROP = 0x07,
+    SWAP = 0x08,
+
+    ADD = 0x09,
+    SUB = 0x0A,
+
+    LT = 0x0B,
+    GT = 0x0C,
+    EQ = 0x0D,
+
+    AND = 0x0E,
+    OR  = 0x0F,
+    NOT = 0x10,
+
+    JZ  = 0x11, // [rel8] pop and jump forward if zero
+    JMP = 0x12, // [rel8] jump forward
+
+    LEN,
+};
+
+/**
+ * @brief Result of the last program run.
+ */
+enum class Status : uint8_t {
+    EMPTY   = 0, // no program is loaded
+    OK      = 1,
+    NO_DATA = 2, // the requested sample is not cached yet
+    STACK   = 3, // stack overflow or underflow
+    INVALID = 5, // unknown instruction (4 was the removed step budget)
+};
+
+/**
+ * @brief Adapter used by the machine to access the sensor cache.
+ */
+struct VmAdapter {
+    void* ctx;
+
+    /**
+     * @brief Copies `size` bytes at `offset` of the sample `age` measurements old into `out`.
+     *
+     * @return false if the sensor or the sample does not exist.
+     */
+    bool (*load)(void*, uint8_t sensor, uint8_t age, uint8_t offset, uint8_t size, uint8_t* out);
+
+    uint8_t sensors_count;
+};
+
+/**
+ * @brief Tiny stack based machine running user programs after each measurement cycle.
+ */
+class Machine {
+public:
+    static constexpr uint8_t program_capacity = 64;
+    static constexpr uint8_t stack_size       = 8;
+
+    /**
+     * @brief Initializes the machine and loads the program persisted in the EEPROM (if it is valid).
+     */
+    void init(VmAdapter adapter);
+
+    /**
+     * @brief Verifies and loads the program into the SRAM slot.
+     *
+     * @return false if the program is rejected, the previous program is kept.
+     */
+    bool load(const uint8_t* program, uint8_t size);
+
+    /**
+     * @brief Writes the program in the SRAM slot to the EEPROM.
+     */
+    void persist() const;
+
+    /**
+     * @brief Runs the loaded program.
+     */
+    void run();
+
+    [[nodiscard]] Status status() const { return m_status; }
+
+    [[nodiscard]] int16_t result() const { return m_result; }
+
+    [[nodiscard]] uint8_t size() const { return m_size; }
+
+    /**
+     * @brief Checks that the program is well formed.
+     *
+     * All opcodes must be known, all operands present, sensor ids in range and jumps must land on an instruction
+     * boundary ahead of them.
+     */
+    static bool verify(const uint8_t* program, uint8_t size, uint8_t sensors_count);
+
+private:
+    microstd::types::array_t<uint8_t, program_capacity> m_program;
+    uint8_t m_size = 0;
+
+    Status m_status  = Status::EMPTY;
+    int16_t m_result = 0;
+
+    VmAdapter m_adapter;
+};
+
+}
+
+#endif
@@ -3,6 +3,19 @@
 #include <microstd/mcu/io.h>
 #include <stdint.h>
 
-uint32_t g_seconds = 0;
+uint32_t g_millis = 0;
+uint32_t g_uptime = 0;
 
-SIGNAL(INT_TIMER1_COMPA) { g_seconds += 1; }
+namespace {
+    uint16_t s_second_millis = 0;
+}
+
+SIGNAL(INT_TIMER1_COMPA) {
+    g_millis += 1;
+
+    s_second_millis += 1;
+    if (s_second_millis == 1000) {
+        s_second_millis = 0;
+        g_uptime += 1;
+    }
+}
@@ -0,0 +1,133 @@
+#include "com/twi.h"
+
+#include <microstd/mcu/io.h>
+#include <stdint.h>
+
+using namespace microstd::mcu::io;
+
+namespace {
+
+constexpr uint8_t QUEUE_MASK = com::twi::QUEUE_SIZE - 1;
+
+static_assert((com::twi::QUEUE_SIZE & QUEUE_MASK) == 0, "The queue size must be a power of 2");
+
+// status codes of the master transmitter
+constexpr uint8_t STATUS_MASK    = 0xF8;
+constexpr uint8_t START          = 0x08;
+constexpr uint8_t REPEATED_START = 0x10;
+constexpr uint8_t ADDRESS_ACK    = 0x18;
+constexpr uint8_t DATA_ACK       = 0x28;
+
+// The queue holds the transfers as [address, size, bytes...]. The interrupt handler consumes the bytes from the head,
+// `end` publishes the bytes written at the write position by moving the tail.
+uint8_t s_queue[com::twi::QUEUE_SIZE];
+
+volatile uint8_t s_head = 0;
+volatile uint8_t s_tail = 0;
+uint8_t s_write         = 0;
+
+volatile bool s_busy      = false;
+volatile uint8_t s_errors = 0;
+
+uint16_t s_queued_bytes = 0;
+
+// bytes left in the transmitted transfer, used only by the interrupt handler
+uint8_t s_remaining = 0;
+
+uint8_t take() {
+    const uint8_t head = s_head;
+    s_head             = (head + 1) & QUEUE_MASK;
+    return s_queue[head];
+}
+
+}
+
+namespace com::twi {
+
+void init(uint32_t frequency) {
+    // prescaler 1
+    TWSR::write(0);
+    TWBR::write(static_cast<uint8_t>(((F_CPU / frequency) - 16) / 2));
+    TWCR::write<TWEN>();
+}
+
+uint8_t available() { return QUEUE_MASK - ((s_write - s_head) & QUEUE_MASK); }
+
+bool begin(uint8_t address, uint8_t size) {
+    if (available() < size + 2) {
+        return false;
+    }
+
+    push(address);
+    push(size);
+
+    s_queued_bytes += size + 1;
+    return true;
+}
+
+void push(uint8_t byte) {
+    s_queue[s_write] = byte;
+    s_write          = (s_write + 1) & QUEUE_MASK;
+}
+
+void end() {
+    s_tail = s_write;
+
+    // The interrupt handler clears the flag only when it did not see the new tail
+    if (!s_busy) {
+        s_busy = true;
+
+        // the STOP condition of the previous transmission may still be in progress
+        while ((TWCR::read() & TWSTO::bit) != 0) { }
+
+        TWCR::write<TWINT, TWEN, TWIE, TWSTA>();
+    }
+}
+
+bool idle() { return !s_busy; }
+
+uint16_t queued_bytes() { return s_queued_bytes; }
+
+uint8_t errors() { return s_errors; }
+
+}
+
+SIGNAL(INT_TWI) {
+    switch (TWSR::read() & STATUS_MASK) {
+    case START:
+    case REPEATED_START:
+        // SLA+W
+        TWDR::write(static_cast<uint8_t>(take() << 1));
+        s_remaining = take();
+        TWCR::write<TWINT, TWEN, TWIE>();
+        return;
+
+    case ADDRESS_ACK:
+    case DATA_ACK:
+        if (s_remaining > 0) {
+            s_remaining -= 1;
+            TWDR::write(take());
+            TWCR::write<TWINT, TWEN, TWIE>();
+            return;
+        }
+        break;
+
+    default:
+        // not acknowledged or a bus error, the rest of the transfer is dropped
+        s_head      = (s_head + s_remaining) & QUEUE_MASK;
+        s_remaining = 0;
+
+        if (s_errors != 0xFF) {
+            s_errors = s_errors + 1;
+        }
+        break;
+    }
+
+    if (s_head != s_tail) {
+        // STOP followed by the START of the next transfer
+        TWCR::write<TWINT, TWEN, TWIE, TWSTO, TWSTA>();
+    } else {
+        s_busy = false;
+        TWCR::write<TWINT, TWEN, TWSTO>();
+    }
+}
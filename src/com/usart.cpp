@@ -89,6 +89,12 @@ void send(const char* msg) {
     }
 }
 
+void send(types::flash_string msg) {
+    for (uint8_t i = 0; msg[i] != '\0'; ++i) {
+        send(static_cast<uint8_t>(msg[i]));
+    }
+}
+
 void send_hex(uint8_t number) {
     uint8_t top    = (number >> 4) & 0xF;
     uint8_t bottom = number & 0xF;
@@ -0,0 +1,119 @@
+#include "input.h"
+#include "clock.h"
+#include "types/progmem.h"
+
+#include <avr/pgmspace.h>
+#include <microstd/mcu/io.h>
+#include <stdint.h>
+
+using namespace microstd::mcu::io;
+
+namespace {
+
+constexpr uint8_t QUEUE_MASK = input::QUEUE_SIZE - 1;
+
+static_assert((input::QUEUE_SIZE & QUEUE_MASK) == 0, "The queue size must be a power of 2");
+
+// encoder transitions per scroll event, one event per edge of CLK
+constexpr int8_t TRANSITIONS_PER_STEP = 2;
+
+/**
+ * Direction of the encoder transition, the index is the previous state << 2 | the current state, where the state is
+ * CLK << 1 | DT. The invalid transitions (both signals changed) count as no movement.
+ */
+constexpr int8_t QUADRATURE[16] PROGMEM = {
+    0, -1, 1, 0,  // from 00
+    1, 0, 0, -1,  // from 01
+    -1, 0, 0, 1,  // from 10
+    0, 1, -1, 0,  // from 11
+};
+
+volatile input::Event s_events[input::QUEUE_SIZE];
+volatile uint8_t s_head = 0;
+volatile uint8_t s_tail = 0;
+
+// used only by the interrupt handler
+uint8_t s_encoder_state = 0;
+int8_t s_transitions    = 0;
+
+bool s_button_down        = false;
+uint32_t s_button_edge_at = 0;
+
+uint8_t encoder_state(uint8_t pin) {
+    return static_cast<uint8_t>((((pin & PIND3::bit) != 0) ? 2 : 0) | (((pin & PIND2::bit) != 0) ? 1 : 0));
+}
+
+void push(input::Event event) {
+    const uint8_t tail = s_tail;
+    const uint8_t next = (tail + 1) & QUEUE_MASK;
+
+    if (next == s_head) {
+        return;
+    }
+
+    s_events[tail] = event;
+    s_tail         = next;
+}
+
+}
+
+namespace input {
+
+void init() {
+    DDRD::unset_bits<DDRD2, DDRD3, DDRD4>();
+    PORTD::unset_bits<PORTD2, PORTD3>();
+    // pull up resistor for button
+    PORTD::set_bits<PORTD4>();
+
+    const uint8_t pin = PIND::read();
+    s_encoder_state   = encoder_state(pin);
+    s_button_down     = (pin & PIND4::bit) == 0;
+
+    PCMSK2::set_bits<PCINT18, PCINT19, PCINT20>();
+    PCICR::set_bits<PCIE2>();
+}
+
+bool pending() { return s_head != s_tail; }
+
+bool take(Event& event) {
+    const uint8_t head = s_head;
+    if (head == s_tail) {
+        return false;
+    }
+
+    event  = s_events[head];
+    s_head = (head + 1) & QUEUE_MASK;
+    return true;
+}
+
+}
+
+SIGNAL(INT_PCINT2) {
+    const uint8_t pin = PIND::read();
+
+    const uint8_t state = encoder_state(pin);
+    if (state != s_encoder_state) {
+        s_transitions += types::progmem_read(&QUADRATURE[(s_encoder_state << 2) | state]);
+        s_encoder_state = state;
+
+        if (s_transitions >= TRANSITIONS_PER_STEP) {
+            s_transitions = 0;
+            push(input::Event::SCROLL_UP);
+        } else if (s_transitions <= -TRANSITIONS_PER_STEP) {
+            s_transitions = 0;
+            push(input::Event::SCROLL_DOWN);
+        }
+    }
+
+    // The first edge of a bounce is the real change, the following edges are ignored for the debounce time. The
+    // interrupts are disabled here, so the milliseconds can be read directly.
+    const bool down = (pin & PIND4::bit) == 0;
+    if (down != s_button_down && (g_millis - s_button_edge_at) >= input::DEBOUNCE_MS) {
+        s_button_down    = down;
+        s_button_edge_at = g_millis;
+
+        if (!down) {
+            push(input::Event::BUTTON);
+        }
+    }
+}
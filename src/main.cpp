@@ -7,7 +7,11 @@
 
 #include "component/sensor/dht11.h"
 #include "component/sensor/joystick.h"
-#include "types/sensor_pin.h"
+#include "input.h"
+#include "types/filters.h"
+#include "types/io_pin.h"
+#include "types/sensor_array.h"
+#include "types/sensor_meta.h"
 #include "types/sensors.h"
 
 constexpr uint16_t baudrate = 9600;
@@ -19,14 +23,29 @@ using microstd::mcu::avr::Input;
 using ADC = io::AnalogConverter;
 
 using namespace component::sensor;
+using ::types::field_meta_t;
+using ::types::Deadband;
+using ::types::EMA;
+using ::types::fields;
+using ::types::Filtered;
+using ::types::io_pin_t;
+using ::types::Median;
+using ::types::Port;
+using ::types::SensorArray;
 using ::types::SensorBase;
 using ::types::SensorFlags;
+using ::types::sensor_instance_t;
+using ::types::sensor_meta_t;
 using ::types::SensorsCollection;
 
 using joystick_info_t = JoystickInfo<Input::ADC5, Input::ADC4>;
 using joystick        = Joystick<ADC, joystick_info_t>;
 
-using temperature = dht11<::types::SensorPin<io::PORTD4, io::DDRD4, io::PIND4>, io::Timer0>;
+using temperature = dht11_pin<io::Timer0>;
+
+// Watch rules
+constexpr uint8_t RULE_ABOVE = 0;
+constexpr uint8_t RULE_BELOW = 1;
 
 struct JoystickData {
     uint16_t x;
@@ -34,12 +53,27 @@ struct JoystickData {
 };
 
 struct TemperatureData {
-    uint8_t temp;
+    int16_t temp; // tenths of degree Celsius
 };
 
-struct JoystickSensor : SensorBase<JoystickData, SensorFlags::HAS_ENABLE | SensorFlags::HAS_WATCH> {
-    // Shortcut to base
-    using Base = SensorBase<JoystickData, SensorFlags::HAS_ENABLE | SensorFlags::HAS_WATCH>;
+// Data layout used for sending the data
+using joystick_fields_t    = fields<&JoystickData::x, &JoystickData::y>;
+using temperature_fields_t = fields<&TemperatureData::temp>;
+
+struct JoystickSensor : SensorBase<
+                            JoystickData,
+                            SensorFlags::HAS_ENABLE | SensorFlags::HAS_WATCH | SensorFlags::HAS_DEDUP,
+                            joystick_fields_t> {
+    // The filtered value is held by the deadband, so the repeated measurements are counted instead of cached
+    static constexpr uint16_t dedup_band = 0;
+
+    // Metadata returned by the discovery command
+    static constexpr sensor_meta_t meta PROGMEM = { .name = "joystick" };
+
+    static constexpr field_meta_t fields_meta[] PROGMEM = {
+        SENSOR_FIELD(JoystickData, x, "raw", 0),
+        SENSOR_FIELD(JoystickData, y, "raw", 0),
+    };
 
     static optional_data_t measure() {
 
@@ -58,61 +92,134 @@ struct JoystickSensor : SensorBase<JoystickData, SensorFlags::HAS_ENABLE | Senso
     // This function is called when the sensor is disabled
     static void disable() { }
 
-    // This function is called when the sensor is read
-    static void usart_send(const data_t& data) {
-        Base::usart_send(data.x);
-        Base::usart_send(data.y);
-    }
-
-    // This function is called after the measure() only if the watch is enabled
-    static void watch(const data_t& data) {
-        if (data.x > 512) {
+    // This function is called after the measure() only if the watch is enabled. The returned event is stored in the
+    // event queue.
+    static optional_watch_t watch(const data_t& data) {
+        const bool above = data.x > 512;
+        if (above) {
             io::PORTB5::set();
 
         } else {
             io::PORTB5::unset();
         }
+
+        if (above == triggered) {
+            return optional_watch_t::none();
+        }
+
+        triggered = above;
+        return optional_watch_t::some({
+            .rule  = above ? RULE_ABOVE : RULE_BELOW,
+            .value = static_cast<int16_t>(data.x),
+        });
     }
+
+private:
+    static inline bool triggered = false;
 };
 
-struct TemperatureSensor : SensorBase<TemperatureData, SensorFlags::HAS_ENABLE | SensorFlags::HAS_WATCH> {
-    // Shortcut to base
-    using Base = SensorBase<TemperatureData, SensorFlags::HAS_ENABLE | SensorFlags::HAS_WATCH>;
+// Driver shared by all DHT11 sensors, the pins are set in the sensor array below
+struct TemperatureDriver : SensorBase<
+                               TemperatureData,
+                               SensorFlags::HAS_ENABLE | SensorFlags::HAS_WATCH | SensorFlags::HAS_DEDUP,
+                               temperature_fields_t> {
+    // The temperature changes slowly, measurements within 0.1 C are counted as repeats
+    static constexpr uint16_t dedup_band = 1;
 
-    static optional_data_t measure() {
+    static constexpr sensor_meta_t meta PROGMEM = { .name = "dht11" };
+
+    static constexpr field_meta_t fields_meta[] PROGMEM = {
+        SENSOR_FIELD(TemperatureData, temp, "C", -1),
+    };
+
+    static optional_data_t measure(const sensor_instance_t& sensor) {
         dht11_data_t data;
 
-        if (temperature::measure(data)) {
-            return optional_data_t::some(
-                TemperatureData {
-                    .temp = data.temperature_int,
-                }
-            );
+        if (temperature::measure(sensor.pin, data)) {
+            return optional_data_t::some(convert(data));
         }
 
         return optional_data_t::none();
     }
 
-    static void enable() { temperature::prepare(); }
+    // The split measurement lets the other sensors measure during the start signal. All instances are started in
+    // one pass, so the last start time is kept and the earlier instances hold the start signal slightly longer.
+    static bool begin_measure(const sensor_instance_t& sensor) {
+        temperature::start(sensor.pin);
+        started = millis();
+        return true;
+    }
 
-    static void disable() { }
+    static ::types::MeasureStatus poll_measure(const sensor_instance_t& sensor, data_t& out) {
+        if (millis() - started <= temperature::start_time) {
+            return ::types::MeasureStatus::PENDING;
+        }
+
+        dht11_data_t data;
+        if (!temperature::read(sensor.pin, data)) {
+            return ::types::MeasureStatus::FAILED;
+        }
+
+        out = convert(data);
+        return ::types::MeasureStatus::DONE;
+    }
+
+    static void enable(const sensor_instance_t& sensor) { temperature::prepare(sensor.pin); }
 
-    static void usart_send(const data_t& data) { Base::usart_send(data.temp); }
+    static void disable(const sensor_instance_t&) { }
 
-    static void watch(const data_t& data) {
-        if (data.temp > 25) {
+    static optional_watch_t watch(const sensor_instance_t& sensor, const data_t& data) {
+        const auto bit   = static_cast<uint8_t>(1 << sensor.index);
+        const bool above = data.temp > 250;
+        if (above) {
             io::PORTB5::set();
         } else {
             io::PORTB5::unset();
         }
+
+        if (above == ((triggered & bit) != 0)) {
+            return optional_watch_t::none();
+        }
+
+        triggered ^= bit;
+        return optional_watch_t::some({
+            .rule  = above ? RULE_ABOVE : RULE_BELOW,
+            .value = data.temp,
+        });
+    }
+
+private:
+    static inline uint8_t triggered = 0; // one bit per instance
+    static inline uint32_t started  = 0;
+
+    static TemperatureData convert(const dht11_data_t& data) {
+        // the decimal part holds tenths, the highest bit marks a negative temperature
+        auto temp = static_cast<int16_t>((data.temperature_int * 10) + (data.temperature_dec & 0x0F));
+        if ((data.temperature_dec & 0x80) != 0) {
+            temp = static_cast<int16_t>(-temp);
+        }
+
+        return TemperatureData { .temp = temp };
     }
 };
 
+// The pin of the DHT11, it must not be one of the input pins (the encoder and the button)
+constexpr io_pin_t DHT11_PIN = { Port::D, 7 };
+
+static_assert(DHT11_PIN.port != Port::D || (input::PORTD_PINS & (1 << DHT11_PIN.bit)) == 0,
+              "The DHT11 pin is read by the input interrupt");
+
+// Every pin adds a DHT11 with its own sensor id, cache and enable/watch bits. The instances share the driver code.
+using TemperatureSensors = SensorArray<TemperatureDriver, DHT11_PIN>;
+
+// The raw joystick readings are noisy, so the samples are filtered before they are cached, watched and sent.
+using FilteredJoystickSensor = Filtered<JoystickSensor, Median<3>, EMA<1, 4>, Deadband<4>>;
+
 // The first argument is number of cached values for each sensor. If the sensor is disabled then the value is
 // copied from last cached value. After the whole cache is full then the oldest value is dropped.
 //
 // The next arguments are sensors.
-using app_t = App<true, 5, TemperatureSensor, JoystickSensor>;
+using app_t = App<true, 5, TemperatureSensors, FilteredJoystickSensor>;
 
 int main() {
     microstd::mcu::io::DDRB5::set();
@@ -1,259 +1,332 @@
 #include "ui.h"
+#include "clock.h"
 #include "com/usart.h"
+#include "component/display/ssd1306.h"
+#include "input.h"
+#include "menu.h"
+#include "types/flash_string.h"
+#include "types/format.h"
+#include "types/progmem.h"
 #include <microstd/int_types.h>
-#include <microstd/mcu/io.h>
 #include <microstd/types/array.h>
 
-using namespace microstd::mcu;
+namespace {
+component::display::SSD1306 s_display;
+}
 
 constexpr microstd::uint8_t MENU_OFFSET_X       = 4;
 constexpr microstd::uint8_t MENU_INDICATOR_SIZE = 2;
-constexpr char MENU_INDICATOR_SYMBOL            = '*';
 
 constexpr auto MENU_ITEM_OFFSET_X = MENU_OFFSET_X + MENU_INDICATOR_SIZE;
 constexpr auto MENU_ITEM_Y_SIZE   = 2;
 constexpr auto MENU_ITEM_OFFSET_Y = 1;
 
-void UI::init_counter() {
-    io::DDRD::unset_bits<io::DDRD2, io::DDRD3, io::DDRD4>();
-    io::PORTD::unset_bits<io::PORTD2, io::PORTD3>();
-    // pull up resistor for button
-    io::PORTD::set_bits<io::PORTD4>();
-
-    m_counter_clk = (io::PIND::read() & io::PIND3::bit) != 0;
+// display traffic of the dashboard and graph refreshes, the budget is accumulated up to the burst
+constexpr microstd::int32_t DASHBOARD_BYTES_PER_SECOND = 1024;
+constexpr microstd::int32_t DASHBOARD_BURST_BYTES      = 512;
+
+constexpr menu::option_t INTERVAL_UNITS[] PROGMEM = {
+    { "seconds" },
+    { "minutes" },
+    { " hours " },
+};
+
+constexpr menu::item_t DEFAULT_ITEMS[] PROGMEM = {
+    menu::link("Sensors", menu::Screen::SENSORS),
+    menu::link("Dashboard", menu::Screen::DASHBOARD),
+    menu::link("Interval", menu::Screen::INTERVAL),
+    menu::link("Exit", menu::Screen::SLEEP),
+};
+
+constexpr menu::item_t SENSORS_ITEMS[] PROGMEM = {
+    menu::number("Sensor:", menu::Value::SENSOR, 0, menu::SENSORS_LIMIT),
+    menu::toggle("Enabled:", menu::Value::SENSOR_ENABLED),
+    menu::toggle("Watch:", menu::Value::SENSOR_WATCH),
+    menu::command("Exit", menu::Command::BACK),
+};
+
+constexpr menu::item_t INTERVAL_ITEMS[] PROGMEM = {
+    menu::choice("Unit:", menu::Value::INTERVAL_UNIT, INTERVAL_UNITS),
+    menu::number("Value:", menu::Value::INTERVAL, 1, 100),
+    menu::command("Restore & exit", menu::Command::RESTORE_INTERVAL),
+    menu::command("Save & exit", menu::Command::SAVE_INTERVAL),
+};
+
+// indexed by the screen
+constexpr menu::menu_t MENUS[] PROGMEM = {
+    menu::make_menu(DEFAULT_ITEMS, menu::Screen::DEFAULT),
+    menu::make_menu(SENSORS_ITEMS, menu::Screen::DEFAULT),
+    menu::make_menu(INTERVAL_ITEMS, menu::Screen::DEFAULT),
+    menu::make_screen(menu::Screen::DEFAULT),
+    menu::make_screen(menu::Screen::DASHBOARD),
+    menu::make_screen(menu::Screen::DEFAULT),
+};
+
+static_assert(sizeof(MENUS) / sizeof(MENUS[0]) == static_cast<microstd::uint8_t>(menu::Screen::SLEEP) + 1);
+
+menu::menu_t UIBase::read_menu(menu::Screen screen) {
+    return types::progmem_read(&MENUS[static_cast<microstd::uint8_t>(screen)]);
 }
 
-void UI::update_counter() {
-    constexpr microstd::uint8_t debounce_threshold = 10;
+menu::item_t UIBase::read_item(const menu::menu_t& menu, item_t i) { return types::progmem_read(&menu.items[i]); }
 
-    auto pin = io::PIND::read();
+void UIBase::update_value(value_t& value, value_t min, value_t max) const {
+    if (m_event == input::Event::SCROLL_UP) {
+        value += 1;
+        if (value >= max) {
+            value = min;
+        }
 
-    // button is up
-    if ((pin & io::PIND4::bit) != 0) {
+    } else if (m_event == input::Event::SCROLL_DOWN) {
+        if (value > min) {
+            value -= 1;
+        } else {
+            value = max - 1;
+        }
+    }
+}
 
-        if (m_btn_counter > 0) {
-            m_btn_counter -= 1;
+void UIBase::update_menu_item(value_t length) { update_value(m_menu_item, 0, length); }
 
-            m_btn_state_prev = m_btn_state;
-            m_btn_state      = BtnState::Up;
+bool UIBase::navigate(const menu::menu_t& menu, menu::Value& toggled) {
+    const menu::item_t item = read_item(menu, m_menu_item);
 
-            // button press
-            if (m_btn_state_prev == BtnState::Down) {
-                request_update(UPDATE_BUTTON);
-            }
+    if (m_value_input) {
+        value_t* edited = edited_value(static_cast<menu::Value>(item.target));
+        if (edited != nullptr) {
+            update_value(*edited, item.min, item_limit(item));
         }
     } else {
-        if (m_btn_counter < debounce_threshold) {
-            m_btn_counter += 1;
-        }
-
-        if (m_btn_counter >= debounce_threshold) {
-            m_btn_state_prev = m_btn_state;
-            m_btn_state      = BtnState::Down;
-        }
+        update_menu_item(menu.count);
     }
 
-    bool clk = (pin & io::PIND3::bit) != 0;
-
-    if (clk != m_counter_clk) {
-        bool dt = (pin & io::PIND2::bit) != 0;
-        if (dt != clk) {
-            m_counter += 1;
-        } else {
-            m_counter -= 1;
-        }
+    if (!btn_pressed()) {
+        return false;
+    }
 
-        request_update(UPDATE_SCROLL);
+    switch (item.kind) {
+    case menu::Kind::LINK:
+        open(static_cast<menu::Screen>(item.target));
+        break;
+    case menu::Kind::COMMAND:
+        run_command(static_cast<menu::Command>(item.target));
+        break;
+    case menu::Kind::NUMBER:
+    case menu::Kind::CHOICE:
+        m_value_input ^= true;
+        break;
+    case menu::Kind::TOGGLE:
+        toggled = static_cast<menu::Value>(item.target);
+        return true;
     }
 
-    m_counter_clk = clk;
+    return false;
 }
 
-bool UI::btn_pressed() { return m_btn_state_prev == BtnState::Down && m_btn_state == BtnState::Up; }
+void UIBase::open(menu::Screen screen) {
+    m_menu        = screen;
+    m_menu_item   = 0;
+    m_value_input = false;
+}
 
-void UI::update_value(value_t& value, value_t min, value_t max) const {
-    if ((m_update & UPDATE_SCROLL) == 0) {
-        return;
-    }
+void UIBase::back() {
+    const menu::Screen screen = m_menu;
+    const menu::Screen parent = read_menu(screen).parent;
 
-    if (m_prev_counter < m_counter) {
-        value += 1;
-        if (value >= max) {
-            value = min;
-        }
+    open(parent);
 
-    } else {
-        if (value > min) {
-            value -= 1;
-        } else {
-            value = max - 1;
+    const menu::menu_t menu = read_menu(parent);
+
+    // select the item which opened the screen
+    for (item_t i = 0; i < menu.count; ++i) {
+        const menu::item_t item = read_item(menu, i);
+        if (item.kind == menu::Kind::LINK && item.target == static_cast<microstd::uint8_t>(screen)) {
+            m_menu_item = i;
+            break;
         }
     }
 }
 
-void UI::update_menu_item(value_t length) { update_value(m_menu_item, 0, length); }
+void UIBase::run_command(menu::Command command) {
+    switch (command) {
+    case menu::Command::SAVE_INTERVAL:
+        m_interval_real      = m_interval;
+        m_interval_unit_real = m_interval_unit;
 
-void UI::default_menu() {
-    // update menu item selection
-    update_menu_item(static_cast<item_t>(DefaultMenu::Len));
-
-    if (btn_pressed()) {
-
-        switch (static_cast<DefaultMenu>(m_menu_item)) {
-        case DefaultMenu::Sensors:
-            m_menu = Menu::Sensors;
+        switch (static_cast<IntervalUnit>(m_interval_unit)) {
+        case Seconds:
+            *m_delay = m_interval;
             break;
-        case DefaultMenu::Interval:
-            m_menu = Menu::Interval;
+        case Minutes:
+            *m_delay = static_cast<uint32_t>(m_interval) * 60;
             break;
-        case DefaultMenu::Sleep:
-            m_menu = Menu::Sleep;
+        case Hours:
+            *m_delay = static_cast<uint32_t>(m_interval) * 60 * 60;
             break;
         default:
             break;
         }
-        m_menu_item = 0;
+        break;
+    case menu::Command::RESTORE_INTERVAL:
+        m_interval_unit = m_interval_unit_real;
+        m_interval      = m_interval_real;
+        break;
+    case menu::Command::BACK:
+        break;
     }
+
+    back();
 }
 
-void UI::interval_menu() {
-    if (m_value_input) {
-        switch (static_cast<IntervalMenu>(m_menu_item)) {
-        case IntervalMenu::IntervalUnit:
-            update_value(m_interval_unit, 0, static_cast<value_t>(IntervalUnit::Len));
-            break;
-        case IntervalMenu::IntervalValue:
-            update_value(m_interval, 1, 100);
-            break;
-        default:
-            m_value_input = false;
-            break;
-        }
-    } else {
-        update_menu_item(static_cast<item_t>(IntervalMenu::Len));
+UIBase::value_t* UIBase::edited_value(menu::Value value) {
+    switch (value) {
+    case menu::Value::INTERVAL:
+        return &m_interval;
+    case menu::Value::INTERVAL_UNIT:
+        return &m_interval_unit;
+    case menu::Value::SENSOR:
+        return &m_sensor_id;
+    default:
+        return nullptr;
     }
+}
 
-    if (btn_pressed()) {
-        switch (static_cast<IntervalMenu>(m_menu_item)) {
-        case IntervalMenu::IntervalUnit:
-        case IntervalMenu::IntervalValue:
-            m_value_input ^= true;
-            break;
+UIBase::value_t UIBase::item_value(const menu::item_t& item) const {
+    if (item.kind == menu::Kind::LINK || item.kind == menu::Kind::COMMAND) {
+        return 0;
+    }
 
-        case IntervalMenu::Save:
-            m_menu        = Menu::Default;
-            m_menu_item   = static_cast<item_t>(DefaultMenu::Interval);
-            m_value_input = false;
-
-            m_interval           = m_interval_real;
-            m_interval_unit_real = m_interval_unit;
-
-            switch (static_cast<IntervalUnit>(m_interval_unit)) {
-            case Seconds:
-                m_adapter.set_interval(m_adapter.ctx, m_interval);
-                break;
-            case Minutes:
-                m_adapter.set_interval(m_adapter.ctx, static_cast<uint32_t>(m_interval) * 60);
-                break;
-            case Hours:
-                m_adapter.set_interval(m_adapter.ctx, static_cast<uint32_t>(m_interval) * 60 * 60);
-                break;
-            default:
-                break;
-            }
-            break;
-        case IntervalMenu::Restore:
-            m_menu        = Menu::Default;
-            m_menu_item   = static_cast<item_t>(DefaultMenu::Interval);
-            m_value_input = false;
+    switch (static_cast<menu::Value>(item.target)) {
+    case menu::Value::INTERVAL:
+        return m_interval;
+    case menu::Value::INTERVAL_UNIT:
+        return m_interval_unit;
+    case menu::Value::SENSOR:
+        return m_sensor_id;
+    default:
+        return 0;
+    }
+}
 
-            m_interval_unit = m_interval_unit_real;
-            m_interval      = m_interval_real;
-            break;
-        default:
-            m_menu_item   = 0;
-            m_value_input = false;
-            break;
-        }
+UIBase::value_t UIBase::item_limit(const menu::item_t& item) const {
+    if (item.kind == menu::Kind::NUMBER && item.limit == menu::SENSORS_LIMIT) {
+        return m_sensor_count;
     }
+
+    return item.limit;
 }
 
-void UI::sensors_menu() {
-    if (m_value_input) {
-        switch (static_cast<SensorsMenu>(m_menu_item)) {
-        case SensorsMenu::Sensor:
-            update_value(m_sensor_id, 0, m_sensor_count);
-            break;
-        default:
-            m_value_input = false;
-            break;
-        }
-    } else {
-        update_menu_item(static_cast<item_t>(SensorsMenu::Len));
+void UIBase::dashboard_menu() {
+    // the sensors and the exit item
+    update_value(m_dashboard_item, 0, m_sensor_count + 1);
+
+    if (m_dashboard_item < m_dashboard_first) {
+        m_dashboard_first = m_dashboard_item;
+    } else if (m_dashboard_item >= m_dashboard_first + DASHBOARD_ROWS) {
+        m_dashboard_first = m_dashboard_item - DASHBOARD_ROWS + 1;
     }
 
     if (btn_pressed()) {
-        switch (static_cast<SensorsMenu>(m_menu_item)) {
-        case SensorsMenu::Sensor:
-            m_value_input ^= true;
-            break;
+        if (m_dashboard_item == m_sensor_count) {
+            back();
+        } else {
+            open(menu::Screen::GRAPH);
+            m_graph_field = 0;
+            m_graph_valid = false;
+        }
+    }
+}
 
-        case SensorsMenu::SensorEnabled:
-            m_adapter.set_enable(m_adapter.ctx, m_sensor_id, !m_adapter.is_enabled(m_adapter.ctx, m_sensor_id));
-            break;
+bool UIBase::refresh_due() {
+    const bool live = m_menu == menu::Screen::DASHBOARD || m_menu == menu::Screen::GRAPH;
+    if (!live || !m_samples_updated || !s_display.flushed()) {
+        return false;
+    }
 
-        case SensorsMenu::SensorWatch:
-            m_adapter.set_watch(m_adapter.ctx, m_sensor_id, !m_adapter.is_watched(m_adapter.ctx, m_sensor_id));
-            break;
+    const microstd::uint32_t now = millis();
 
-        case SensorsMenu::Exit:
-            m_menu        = Menu::Default;
-            m_menu_item   = static_cast<item_t>(DefaultMenu::Sensors);
-            m_value_input = false;
-            break;
-        default:
-            m_menu_item   = 0;
-            m_value_input = false;
-            break;
-        }
+    // the elapsed time is limited, so the budget does not overflow
+    microstd::uint32_t elapsed = now - m_budget_at;
+    if (elapsed > 1000) {
+        elapsed = 1000;
+    }
+
+    const microstd::uint16_t queued = com::twi::queued_bytes();
+
+    m_budget += static_cast<microstd::int32_t>(elapsed) * DASHBOARD_BYTES_PER_SECOND / 1000;
+    m_budget -= static_cast<microstd::uint16_t>(queued - m_budget_queued);
+    if (m_budget > DASHBOARD_BURST_BYTES) {
+        m_budget = DASHBOARD_BURST_BYTES;
     }
+
+    m_budget_at     = now;
+    m_budget_queued = queued;
+
+    return m_budget >= 0;
 }
 
-#include "lcd.h"
+void UIBase::sleep_menu() {
+    // NOTE: This function is called only for an input event or when the method "request_update" is called.
+    s_display.sleep(false);
+
+    back();
+}
 
-void UI::sleep_menu() {
-    // NOTE: This function is called only when the method "request_update" is called.
-    constexpr auto NO = ~YES;
-    lcd_sleep(NO);
+namespace {
 
-    m_menu      = Menu::Default;
-    m_menu_item = static_cast<item_t>(DefaultMenu::Sleep);
+void display_menu_indicator(microstd::uint8_t selected, char symbol) {
+    s_display.goto_xy(MENU_OFFSET_X, (selected * MENU_ITEM_Y_SIZE) + MENU_ITEM_OFFSET_Y);
+    s_display.putc(symbol);
 }
 
-template <uint8_t Row> void display_menu_item_single(const char* item) {
-    lcd_gotoxy(MENU_ITEM_OFFSET_X, (Row * MENU_ITEM_Y_SIZE) + MENU_ITEM_OFFSET_Y);
-    lcd_puts(item);
 }
 
-template <uint8_t I = 0, typename... Rest> void display_menu_item(const char* item, Rest... rest) {
-    display_menu_item_single<I>(item);
+void UIBase::display_spaces(microstd::uint8_t count) {
+    for (microstd::uint8_t i = 0; i < count; ++i) {
+        s_display.putc(' ');
+    }
+}
 
-    if constexpr (sizeof...(rest) > 0) {
-        display_menu_item<I + 1>(rest...);
+/**
+ * @brief Writes the text padded with spaces to the width.
+ */
+void UIBase::display_text(const char* text, microstd::uint8_t width) {
+    microstd::uint8_t i = 0;
+    for (; text[i] != '\0' && i < width; ++i) {
+        s_display.putc(text[i]);
     }
+
+    display_spaces(width - i);
 }
 
-void display_menu_indicator(microstd::uint8_t selected) {
-    lcd_gotoxy(MENU_OFFSET_X, (selected * MENU_ITEM_Y_SIZE) + MENU_ITEM_OFFSET_Y);
-    lcd_putc(MENU_INDICATOR_SYMBOL);
+/**
+ * @brief Writes the text stored in the program memory (PROGMEM) padded with spaces to the width.
+ */
+void UIBase::display_text(types::flash_string text, microstd::uint8_t width) {
+    microstd::uint8_t i = 0;
+    for (; text[i] != '\0' && i < width; ++i) {
+        s_display.putc(text[i]);
+    }
+
+    display_spaces(width - i);
+}
+
+namespace {
+
+void display_number(microstd::uint8_t value, bool brackets) {
+    s_display.putc(brackets ? '[' : ' ');
+    s_display.putc(static_cast<char>('0' + (value / 10)));
+    s_display.putc(static_cast<char>('0' + (value % 10)));
+    s_display.putc(brackets ? ']' : ' ');
+}
+
+bool has_brackets(bool value_input, microstd::uint8_t item, microstd::uint8_t row) {
+    return value_input && item == row;
 }
 
-template <typename... Items> void display_menu(microstd::uint8_t selected, Items... items) {
-    display_menu_item(items...);
-    display_menu_indicator(selected);
 }
 
-void UI::update_interval(uint32_t interval) {
+void UIBase::update_interval(uint32_t interval) {
     if (interval < 60) {
         m_interval_unit_real = IntervalUnit::Seconds;
         m_interval_real      = interval;
@@ -274,181 +347,122 @@ void UI::update_interval(uint32_t interval) {
     m_value_input = false;
 }
 
-void UI::init(uint32_t interval, AppAdapter adapter, uint8_t sensors_count) {
+void UIBase::init(uint32_t& delay, uint8_t sensors_count) {
 
-    init_counter();
-    lcd_init(LCD_DISP_ON);
+    input::init();
+    s_display.init();
 
-    update_interval(interval);
+    update_interval(delay);
 
-    m_adapter      = adapter;
+    m_delay        = &delay;
     m_sensor_count = sensors_count;
 }
 
-void UI::update() {
-    m_prev_counter = counter();
-    update_counter();
+bool UIBase::begin_update() {
+    // the changes which did not fit into the TWI queue
+    s_display.flush();
 
-    if (m_update == UPDATE_NONE) {
-        return;
-    }
-
-    lcd_clrscr();
-    lcd_home();
+    m_refresh = refresh_due();
 
-    switch (m_menu) {
-    case Default:
-        default_menu();
-        break;
-    case Sensors:
-        sensors_menu();
-        break;
-    case Interval:
-        interval_menu();
-        break;
-    case Sleep:
-        sleep_menu();
-        break;
-    }
-
-    draw_menu();
-    m_update = UPDATE_NONE;
+    return m_update != UPDATE_NONE || input::pending() || m_refresh;
 }
 
-void UI::draw_interval_menu() {
-    // interval unit
-    {
-        display_menu_item_single<0>("Unit:");
-        bool value_input = m_value_input && m_menu_item == 0;
-
-        if (value_input) {
-            lcd_putc('[');
-        } else {
-            lcd_putc(' ');
-        }
-
-        switch (static_cast<IntervalUnit>(m_interval_unit)) {
-        case Seconds:
-            lcd_puts("seconds");
-            break;
-        case Minutes:
-            lcd_puts("minutes");
-            break;
-        case Hours:
-            lcd_puts(" hours ");
-            break;
-        default:
-            break;
-        }
-
-        if (value_input) {
-            lcd_putc(']');
-        }
+bool UIBase::begin_repaint(const view_t& view) {
+    if (m_drawn && view.menu == m_view.menu) {
+        return false;
     }
 
-    // interval value
-    {
-        display_menu_item_single<1>("Value:");
-        bool value_input = m_value_input && m_menu_item == 1;
-
-        if (value_input) {
-            lcd_putc('[');
-        } else {
-            lcd_putc(' ');
-        }
-
-        uint8_t a = m_interval % 10;
-        uint8_t b = m_interval / 10;
+    s_display.clear();
+    s_display.graph(false);
 
-        lcd_putc('0' + b);
-        lcd_putc('0' + a);
+    m_view = view;
+    return true;
+}
 
-        if (value_input) {
-            lcd_putc(']');
-        }
-    }
+void UIBase::end_update(uint32_t start) {
+    m_drawn  = true;
+    m_update = UPDATE_NONE;
 
-    // restore
-    { display_menu_item_single<2>("Restore & exit"); }
+    s_display.flush();
 
-    // exit
-    { display_menu_item_single<3>("Save & exit"); }
+    const uint32_t elapsed = timer_clock_t::ticks() - start;
 
-    // indicator
-    display_menu_indicator(m_menu_item);
+    m_redraw_ticks = (elapsed > 0xFFFF) ? 0xFFFF : static_cast<uint16_t>(elapsed);
+    if (m_redraw_ticks > m_redraw_max_ticks) {
+        m_redraw_max_ticks = m_redraw_ticks;
+    }
 }
 
-void UI::draw_sensors_menu() {
-    // sensor id
-    {
-        display_menu_item_single<0>("Sensor:");
-        bool value_input = m_value_input && m_menu_item == 0;
+component::display::SSD1306& UIBase::display() { return s_display; }
 
-        if (value_input) {
-            lcd_putc('[');
-        } else {
-            lcd_putc(' ');
-        }
-
-        uint8_t a = m_sensor_id % 10;
-        uint8_t b = m_sensor_id / 10;
+void UIBase::draw_items(const menu::menu_t& menu) {
+    for (item_t row = 0; row < menu.count; ++row) {
+        const menu::item_t item = read_item(menu, row);
 
-        lcd_putc('0' + b);
-        lcd_putc('0' + a);
+        s_display.goto_xy(MENU_ITEM_OFFSET_X, (row * MENU_ITEM_Y_SIZE) + MENU_ITEM_OFFSET_Y);
+        s_display.puts(types::flash_string(menu.items[row].label));
 
-        if (value_input) {
-            lcd_putc(']');
-        }
+        draw_item_value(row, item, m_view);
     }
 
-    // enabled
-    {
-        display_menu_item_single<1>("Enabled:");
-
-        lcd_putc('[');
-        if (m_adapter.is_enabled(m_adapter.ctx, m_sensor_id)) {
-            lcd_putc('X');
-        } else {
-            lcd_putc(' ');
-        }
+    display_menu_indicator(m_view.item, INDICATOR_SYMBOL);
+}
 
-        lcd_putc(']');
+void UIBase::draw_item_changes(const menu::menu_t& menu, const view_t& view) {
+    if (view.item != m_view.item) {
+        display_menu_indicator(m_view.item, ' ');
+        display_menu_indicator(view.item, INDICATOR_SYMBOL);
     }
 
-    // watch
-    {
-        display_menu_item_single<2>("Watch:");
+    for (item_t row = 0; row < menu.count; ++row) {
+        const bool brackets_changed = has_brackets(view.value_input, view.item, row)
+            != has_brackets(m_view.value_input, m_view.item, row);
 
-        lcd_putc('[');
-        if (m_adapter.is_watched(m_adapter.ctx, m_sensor_id)) {
-            lcd_putc('X');
-        } else {
-            lcd_putc(' ');
+        if (view.values[row] != m_view.values[row] || brackets_changed) {
+            draw_item_value(row, read_item(menu, row), view);
         }
-        lcd_putc(']');
     }
-
-    // exit
-    { display_menu_item_single<3>("Exit"); }
-
-    // indicator
-    display_menu_indicator(m_menu_item);
 }
 
-void UI::draw_menu() {
+void UIBase::draw_item_value(item_t row, const menu::item_t& item, const view_t& view) {
+    const bool brackets = has_brackets(view.value_input, view.item, row);
+    const value_t value = view.values[row];
+
+    // the value follows the label
+    s_display.goto_xy(MENU_ITEM_OFFSET_X + item.label_length, (row * MENU_ITEM_Y_SIZE) + MENU_ITEM_OFFSET_Y);
 
-    switch (m_menu) {
-    case Default:
-        display_menu(m_menu_item, "Sensors", "Interval", "Exit");
+    switch (item.kind) {
+    case menu::Kind::NUMBER:
+        display_number(value, brackets);
         break;
-    case Interval:
-        draw_interval_menu();
+    case menu::Kind::CHOICE:
+        s_display.putc(brackets ? '[' : ' ');
+        display_text(types::flash_string(item.options[value].text), menu::OPTION_SIZE);
+        s_display.putc(brackets ? ']' : ' ');
         break;
-    case Sensors:
-        draw_sensors_menu();
+    case menu::Kind::TOGGLE:
+        s_display.putc('[');
+        s_display.putc((value != 0) ? 'X' : ' ');
+        s_display.putc(']');
         break;
-    case Sleep:
-        lcd_sleep(YES);
+    default:
         break;
     }
 }
+
+microstd::uint8_t UIBase::graph_y(microstd::int32_t value) const {
+    // unsigned differences do not overflow
+    auto offset = static_cast<microstd::uint32_t>(value) - static_cast<microstd::uint32_t>(m_graph_min);
+    auto range  = static_cast<microstd::uint32_t>(m_graph_max) - static_cast<microstd::uint32_t>(m_graph_min);
+
+    if (range == 0) {
+        return GRAPH_HEIGHT / 2;
+    }
+
+    while (range > 0x00FFFFFF) {
+        offset >>= 8;
+        range >>= 8;
+    }
+
+    return static_cast<microstd::uint8_t>((offset * (GRAPH_HEIGHT - 1)) / range);
+}
@@ -0,0 +1,300 @@
+#include "vm/vm.h"
+#include "types/progmem.h"
+
+#include <avr/eeprom.h>
+#include <avr/pgmspace.h>
+#include <microstd/types/array.h>
+#include <stdint.h>
+
+namespace vm {
+
+namespace {
+
+    /*
+     * Instruction info:
+     * +--------+----------+------+--------+
+     * |  Bits  |   7..4   | 3..2 |  1..0  |
+     * +--------+----------+------+--------+
+     * | Field  | operands | pops | pushes |
+     * +--------+----------+------+--------+
+     */
+    constexpr uint8_t info(uint8_t operands, uint8_t pops, uint8_t pushes) {
+        return (operands << 4) | (pops << 2) | pushes;
+    }
+
+    constexpr uint8_t info_operands(uint8_t value) { return value >> 4; }
+
+    constexpr uint8_t info_pops(uint8_t value) { return (value >> 2) & 0x3; }
+
+    constexpr uint8_t info_pushes(uint8_t value) { return value & 0x3; }
+
+    const uint8_t op_info[static_cast<uint8_t>(Op::LEN)] PROGMEM = {
+        info(0, 0, 0), // HALT
+        info(1, 0, 1), // PUSH8
+        info(2, 0, 1), // PUSH16
+        info(3, 0, 1), // LOAD_U8
+        info(3, 0, 1), // LOAD_I8
+        info(3, 0, 1), // LOAD_I16
+        info(0, 1, 2), // DUP
+        info(0, 1, 0), // DROP
+        info(0, 2, 2), // SWAP
+        info(0, 2, 1), // ADD
+        info(0, 2, 1), // SUB
+        info(0, 2, 1), // LT
+        info(0, 2, 1), // GT
+        info(0, 2, 1), // EQ
+        info(0, 2, 1), // AND
+        info(0, 2, 1), // OR
+        info(0, 1, 1), // NOT
+        info(1, 1, 0), // JZ
+        info(1, 0, 0), // JMP
+    };
+
+    uint8_t EEMEM ee_program_size;
+    uint8_t EEMEM ee_program[Machine::program_capacity];
+
+    uint8_t read_info(uint8_t op) { return types::progmem_read_byte(&op_info[op]); }
+
+    bool is_load(Op op) { return op == Op::LOAD_U8 || op == Op::LOAD_I8 || op == Op::LOAD_I16; }
+
+    bool is_jump(Op op) { return op == Op::JZ || op == Op::JMP; }
+
+}
+
+bool Machine::verify(const uint8_t* program, uint8_t size, uint8_t sensors_count) {
+    if (size > program_capacity) {
+        return false;
+    }
+
+    // one bit for every position including the end of the program
+    constexpr uint8_t mask_size = (program_capacity / 8) + 1;
+    microstd::types::array_t<uint8_t, mask_size> starts;
+    microstd::types::array_t<uint8_t, mask_size> targets;
+
+    for (uint8_t i = 0; i < mask_size; ++i) {
+        starts[i]  = 0;
+        targets[i] = 0;
+    }
+
+    uint8_t pc = 0;
+    while (pc < size) {
+        starts[pc / 8] |= 1 << (pc % 8);
+
+        const uint8_t byte = program[pc];
+        if (byte >= static_cast<uint8_t>(Op::LEN)) {
+            return false;
+        }
+
+        const auto op          = static_cast<Op>(byte);
+        const uint8_t operands = info_operands(read_info(byte));
+
+        if (size - pc - 1 < operands) {
+            return false;
+        }
+
+        if (is_load(op) && program[pc + 1] >= sensors_count) {
+            return false;
+        }
+
+        const uint8_t next = pc + 1 + operands;
+
+        if (is_jump(op)) {
+            const uint16_t target = next + program[pc + 1];
+            if (target > size) {
+                return false;
+            }
+
+            targets[target / 8] |= 1 << (target % 8);
+        }
+
+        pc = next;
+    }
+
+    starts[size / 8] |= 1 << (size % 8);
+
+    for (uint8_t i = 0; i < mask_size; ++i) {
+        if ((targets[i] & ~starts[i]) != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void Machine::init(VmAdapter adapter) {
+    m_adapter = adapter;
+
+    const uint8_t size = eeprom_read_byte(&ee_program_size);
+    if (size > program_capacity) {
+        return;
+    }
+
+    eeprom_read_block(m_program.data(), ee_program, size);
+
+    if (verify(m_program.data(), size, m_adapter.sensors_count)) {
+        m_size   = size;
+        m_status = (size == 0) ? Status::EMPTY : Status::OK;
+    }
+}
+
+bool Machine::load(const uint8_t* program, uint8_t size) {
+    if (!verify(program, size, m_adapter.sensors_count)) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < size; ++i) {
+        m_program[i] = program[i];
+    }
+
+    m_size   = size;
+    m_result = 0;
+    m_status = (size == 0) ? Status::EMPTY : Status::OK;
+    return true;
+}
+
+void Machine::persist() const {
+    eeprom_update_byte(&ee_program_size, m_size);
+    eeprom_update_block(m_program.data(), ee_program, m_size);
+}
+
+void Machine::run() {
+    if (m_size == 0) {
+        m_status = Status::EMPTY;
+        return;
+    }
+
+    microstd::types::array_t<int16_t, stack_size> stack;
+    uint8_t sp = 0;
+    uint8_t pc = 0;
+
+    Status status = Status::OK;
+
+    // The verified jumps go only forward, so every instruction runs at most once and the run time is bounded by the
+    // program size.
+    while (pc < m_size) {
+        const uint8_t byte = m_program[pc];
+        if (byte >= static_cast<uint8_t>(Op::LEN)) {
+            status = Status::INVALID;
+            break;
+        }
+
+        const uint8_t flags = read_info(byte);
+        const uint8_t pops  = info_pops(flags);
+
+        if (sp < pops || sp - pops + info_pushes(flags) > stack_size) {
+            status = Status::STACK;
+            break;
+        }
+
+        const uint8_t* operands = &m_program[pc + 1];
+        pc += 1 + info_operands(flags);
+
+        const auto op = static_cast<Op>(byte);
+
+        if (op == Op::HALT) {
+            break;
+        }
+
+        if (is_load(op)) {
+            uint8_t bytes[2]    = { 0, 0 };
+            const uint8_t width = (op == Op::LOAD_I16) ? 2 : 1;
+
+            if (!m_adapter.load(m_adapter.ctx, operands[0], operands[1], operands[2], width, bytes)) {
+                status = Status::NO_DATA;
+                break;
+            }
+
+            int16_t value;
+            switch (op) {
+            case Op::LOAD_U8:
+                value = bytes[0];
+                break;
+            case Op::LOAD_I8:
+                value = static_cast<int8_t>(bytes[0]);
+                break;
+            default:
+                // AVR is little-endian
+                value = static_cast<int16_t>(bytes[0] | (bytes[1] << 8));
+                break;
+            }
+
+            stack[sp++] = value;
+            continue;
+        }
+
+        switch (op) {
+        case Op::PUSH8:
+            stack[sp++] = static_cast<int8_t>(operands[0]);
+            break;
+        case Op::PUSH16:
+            stack[sp++] = static_cast<int16_t>((operands[0] << 8) | operands[1]);
+            break;
+        case Op::DUP:
+            stack[sp] = stack[sp - 1];
+            sp += 1;
+            break;
+        case Op::DROP:
+            sp -= 1;
+            break;
+        case Op::SWAP: {
+            const int16_t tmp = stack[sp - 1];
+            stack[sp - 1]     = stack[sp - 2];
+            stack[sp - 2]     = tmp;
+            break;
+        }
+        case Op::NOT:
+            stack[sp - 1] = (stack[sp - 1] == 0) ? 1 : 0;
+            break;
+        case Op::JZ:
+            sp -= 1;
+            if (stack[sp] == 0) {
+                pc += operands[0];
+            }
+            break;
+        case Op::JMP:
+            pc += operands[0];
+            break;
+        default: {
+            // binary operations
+            sp -= 1;
+            const int16_t b = stack[sp];
+            const int16_t a = stack[sp - 1];
+            int16_t res     = 0;
+
+            switch (op) {
+            case Op::ADD:
+                res = static_cast<int16_t>(a + b);
+                break;
+            case Op::SUB:
+                res = static_cast<int16_t>(a - b);
+                break;
+            case Op::LT:
+                res = (a < b) ? 1 : 0;
+                break;
+            case Op::GT:
+                res = (a > b) ? 1 : 0;
+                break;
+            case Op::EQ:
+                res = (a == b) ? 1 : 0;
+                break;
+            case Op::AND:
+                res = (a != 0 && b != 0) ? 1 : 0;
+                break;
+            case Op::OR:
+                res = (a != 0 || b != 0) ? 1 : 0;
+                break;
+            default:
+                break;
+            }
+
+            stack[sp - 1] = res;
+            break;
+        }
+        }
+    }
+
+    m_status = status;
+    m_result = (status == Status::OK && sp > 0) ? stack[sp - 1] : 0;
+}
+
+}
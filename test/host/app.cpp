@@ -0,0 +1,169 @@
+#include "app.h"
+#include "mock/clock.h"
+#include "mock/usart.h"
+#include "types/fields.h"
+#include "types/sensors.h"
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <string>
+#include <string_view>
+
+namespace {
+
+using types::SensorBase;
+using types::SensorFlags;
+
+struct LevelData {
+    int16_t level;
+};
+
+struct LevelSensor : SensorBase<LevelData, SensorFlags::HAS_ENABLE, types::fields<&LevelData::level>> {
+    static inline int16_t next = 0;
+
+    static optional_data_t measure() { return optional_data_t::some(LevelData { .level = next }); }
+
+    static void enable() { }
+
+    static void disable() { }
+};
+
+using app_t = App<false, 4, LevelSensor, LevelSensor>;
+
+std::string bytes(std::initializer_list<uint8_t> values) {
+    std::string out;
+    for (const uint8_t value : values) {
+        out.push_back(static_cast<char>(value));
+    }
+
+    return out;
+}
+
+class AppTest : public ::testing::Test {
+protected:
+    app_t m_app;
+
+    void SetUp() override {
+        LevelSensor::next = 0;
+
+        mock::usart::init();
+        m_app.begin(9600);
+    }
+
+    /**
+     * @brief Sends the command and runs the state machine until the response is complete.
+     */
+    std::string command(std::string_view request) {
+        mock::usart::feed(request);
+
+        do {
+            m_app.step();
+        } while (!mock::usart::g_received.empty() || !m_app.idle());
+
+        return mock::usart::take_sent();
+    }
+
+    /**
+     * @brief Gets the enable and the watch bits of the both sensors from the `l` response.
+     */
+    std::string list() {
+        const std::string response = command("l");
+        if (response.size() != 6 || response[0] != 2 || response[1] != 1 || response.substr(4) != "OK") {
+            return "invalid";
+        }
+
+        // the bits of the missing sensors are not defined
+        return bytes({ static_cast<uint8_t>(response[2] & 0b11), static_cast<uint8_t>(response[3] & 0b11) });
+    }
+
+    /**
+     * @brief Waits for the next measurement (the default interval is 5 s).
+     */
+    void measure(int16_t level) {
+        LevelSensor::next = level;
+
+        mock::clock::advance(5000);
+        m_app.step();
+    }
+};
+
+TEST_F(AppTest, UnknownCommand) {
+    EXPECT_EQ(command("x"), "E6");
+    EXPECT_TRUE(m_app.idle());
+}
+
+TEST_F(AppTest, EnableAndDisable) {
+    EXPECT_EQ(command("d001"), "OK");
+    EXPECT_EQ(list(), bytes({ 0b01, 0b00 }));
+
+    EXPECT_EQ(command("e001"), "OK");
+    EXPECT_EQ(command("w000"), "OK");
+    EXPECT_EQ(list(), bytes({ 0b11, 0b01 }));
+
+    EXPECT_EQ(command("c000"), "OK");
+    EXPECT_EQ(list(), bytes({ 0b11, 0b00 }));
+}
+
+TEST_F(AppTest, InvalidSensor) {
+    EXPECT_EQ(command("e002"), "E0");
+    EXPECT_EQ(command("d256"), "E0");
+    EXPECT_EQ(command("e0a1"), "E0");
+
+    // the command with missing digits times out
+    EXPECT_EQ(command("r0"), "E0");
+}
+
+TEST_F(AppTest, SetInterval) {
+    EXPECT_EQ(command("s01s"), "OK");
+    EXPECT_EQ(command("s1xs"), "E2");
+    EXPECT_EQ(command("s01x"), "E3");
+    EXPECT_EQ(command("s0"), "E1");
+}
+
+TEST_F(AppTest, ReadMeasurement) {
+    measure(0x0102);
+    measure(0x0304);
+
+    EXPECT_EQ(command("r000"), bytes({ 0x03, 0x04 }) + "OK");
+    EXPECT_EQ(command("R001"), bytes({ 0x01, 0x02, 0x03, 0x04 }) + "OK");
+}
+
+TEST_F(AppTest, SetCalibration) {
+    // c2 = 0, c1 = 3, offset = -2, divisor = 2 and the checksum
+    const std::string coefficients = bytes({ 0x00, 0x00, 0x00, 0x03, 0xFF, 0xFE, 0x00, 0x02 });
+
+    EXPECT_EQ(command("k001000" + coefficients + bytes({ 0x02 })), "OK");
+    EXPECT_EQ(command("k001000" + coefficients + bytes({ 0x03 })), "E9");
+    EXPECT_EQ(command("k001001" + coefficients + bytes({ 0x02 })), "E9");
+
+    measure(10);
+
+    EXPECT_EQ(command("r000"), bytes({ 0x00, 0x0A }) + "OK");
+    EXPECT_EQ(command("r001"), bytes({ 0x00, 0x0D }) + "OK");
+}
+
+TEST_F(AppTest, ExportAndImportConfig) {
+    EXPECT_EQ(command("d000"), "OK");
+    EXPECT_EQ(command("s02m"), "OK");
+
+    std::string config = command("E");
+    ASSERT_GE(config.size(), 2U);
+    ASSERT_EQ(config.substr(config.size() - 2), "OK");
+    config.resize(config.size() - 2);
+
+    // enable, watch, 120 s (little-endian)
+    EXPECT_EQ(config[0] & 0b11, 0b10);
+    EXPECT_EQ(config[1] & 0b11, 0b00);
+    EXPECT_EQ(config.substr(2, 4), bytes({ 120, 0, 0, 0 }));
+
+    EXPECT_EQ(command("e000"), "OK");
+    EXPECT_EQ(command("s05s"), "OK");
+    EXPECT_EQ(command("I" + config), "OK");
+    EXPECT_EQ(list(), bytes({ 0b10, 0b00 }));
+    EXPECT_EQ(command("E"), config + "OK");
+
+    config.back() = static_cast<char>(config.back() + 1);
+    EXPECT_EQ(command("I" + config), "E5");
+}
+
+}
@@ -0,0 +1,69 @@
+#include "types/bitarray.h"
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+namespace {
+
+using bits_t = types::bitarray<12>;
+
+TEST(Bitarray, StorageSize) {
+    EXPECT_EQ(bits_t::count, 2U);
+    EXPECT_EQ((types::bitarray<8>::count), 1U);
+    EXPECT_EQ((types::bitarray<9, uint16_t>::count), 1U);
+}
+
+TEST(Bitarray, SetAndClear) {
+    bits_t bits;
+    bits.clear_all();
+
+    bits.set(0);
+    bits.set(7);
+    bits.set(8);
+    bits.set(11);
+
+    EXPECT_TRUE(bits.get(0));
+    EXPECT_FALSE(bits.get(1));
+    EXPECT_TRUE(bits.get(7));
+    EXPECT_TRUE(bits.get(8));
+    EXPECT_TRUE(bits.get(11));
+
+    EXPECT_EQ(bits.get_raw(0), 0x81);
+    EXPECT_EQ(bits.get_raw(1), 0x09);
+
+    bits.clear(7);
+    bits.clear(8);
+
+    EXPECT_FALSE(bits.get(7));
+    EXPECT_FALSE(bits.get(8));
+    EXPECT_EQ(bits.get_raw(0), 0x01);
+    EXPECT_EQ(bits.get_raw(1), 0x08);
+}
+
+TEST(Bitarray, SetAllAndClearAll) {
+    bits_t bits;
+
+    bits.set_all();
+    for (uint8_t i = 0; i < 12; ++i) {
+        EXPECT_TRUE(bits.get(i)) << "bit " << int { i };
+    }
+
+    bits.clear_all();
+    for (uint8_t i = 0; i < 12; ++i) {
+        EXPECT_FALSE(bits.get(i)) << "bit " << int { i };
+    }
+}
+
+TEST(Bitarray, ForceWrite) {
+    bits_t bits;
+    bits.clear_all();
+
+    bits.force_write(1, 0x05);
+
+    EXPECT_TRUE(bits.get(8));
+    EXPECT_FALSE(bits.get(9));
+    EXPECT_TRUE(bits.get(10));
+    EXPECT_EQ(bits.get_raw(0), 0x00);
+}
+
+}
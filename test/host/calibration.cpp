@@ -0,0 +1,73 @@
+#include "types/calibration.h"
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+namespace {
+
+using types::calibration_t;
+
+TEST(Calibration, Default) {
+    const calibration_t calibration;
+
+    EXPECT_EQ(calibration.apply<int16_t>(-1234), -1234);
+    EXPECT_EQ(calibration.apply<uint8_t>(200), 200);
+}
+
+TEST(Calibration, RejectsZeroDivisor) {
+    calibration_t calibration;
+
+    EXPECT_FALSE(calibration_t::make(0, 1, 0, 0, calibration));
+}
+
+TEST(Calibration, LinearWithOffset) {
+    calibration_t calibration;
+    ASSERT_TRUE(calibration_t::make(0, 3, -2, 2, calibration));
+
+    EXPECT_EQ(calibration.apply<int16_t>(10), 13);
+    EXPECT_EQ(calibration.apply<int16_t>(11), 14); // 33 / 2 rounded toward zero
+    EXPECT_EQ(calibration.apply<int16_t>(-11), -18);
+}
+
+TEST(Calibration, Quadratic) {
+    calibration_t calibration;
+    ASSERT_TRUE(calibration_t::make(1, 0, 5, 1, calibration));
+
+    EXPECT_EQ(calibration.apply<int16_t>(12), 149);
+    EXPECT_EQ(calibration.apply<int16_t>(-12), 149);
+}
+
+TEST(Calibration, MatchesDivisionForAllDivisors) {
+    constexpr int16_t VALUES[] = { -32768, -999, 0, 1, 32767 };
+
+    calibration_t calibration;
+
+    for (uint32_t divisor = 1; divisor <= 0xFFFF; divisor += 7) {
+        ASSERT_TRUE(calibration_t::make(0, 100, 0, static_cast<uint16_t>(divisor), calibration));
+
+        for (const int16_t x : VALUES) {
+            const int32_t expected = (100 * static_cast<int32_t>(x)) / static_cast<int32_t>(divisor);
+            const int32_t clamped  = expected > 32767 ? 32767 : (expected < -32768 ? -32768 : expected);
+
+            ASSERT_EQ(calibration.apply<int16_t>(x), clamped) << "x = " << x << ", divisor = " << divisor;
+        }
+    }
+}
+
+TEST(Calibration, Saturates) {
+    calibration_t calibration;
+    ASSERT_TRUE(calibration_t::make(0, 10, 0, 1, calibration));
+
+    EXPECT_EQ(calibration.apply<uint8_t>(30), 255);
+    EXPECT_EQ(calibration.apply<int8_t>(-30), -128);
+    EXPECT_EQ(calibration.apply<int16_t>(10000), 32767);
+}
+
+TEST(Calibration, SkipsWideFields) {
+    calibration_t calibration;
+    ASSERT_TRUE(calibration_t::make(0, 10, 3, 1, calibration));
+
+    EXPECT_EQ(calibration.apply<uint32_t>(123456), 123456U);
+}
+
+}
@@ -0,0 +1,82 @@
+#include "component/sensor/dht11.h"
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <vector>
+
+namespace {
+
+using component::sensor::dht11_data_t;
+using component::sensor::dht11_protocol;
+
+/**
+ * @brief Line returning the scripted timer values of the waits, an empty script times out.
+ */
+struct ScriptedLine {
+    static inline std::vector<uint8_t> counts;
+    static inline size_t next = 0;
+
+    void release() const { }
+
+    template <uint8_t Us> bool wait_until_on(uint8_t& count) const { return take(count); }
+
+    template <uint8_t Us> bool wait_until_off(uint8_t& count) const { return take(count); }
+
+    static bool take(uint8_t& count) {
+        if (next == counts.size()) {
+            return false;
+        }
+
+        count = counts[next++];
+        return true;
+    }
+};
+
+/**
+ * @brief Scripts the response with the high time `reference` and the bytes with the high times `zero` and `one`.
+ */
+void script(const std::vector<uint8_t>& bytes, uint8_t reference, uint8_t zero, uint8_t one) {
+    ScriptedLine::counts = { 20, 160, reference };
+    ScriptedLine::next   = 0;
+
+    for (const uint8_t byte : bytes) {
+        for (int bit = 7; bit >= 0; --bit) {
+            ScriptedLine::counts.push_back(100);
+            ScriptedLine::counts.push_back(((byte >> bit) & 1) != 0 ? one : zero);
+        }
+    }
+}
+
+TEST(Dht11, DecodesTheBits) {
+    // 0.5 us per count: 80 us response, 26 us and 70 us bits
+    script({ 45, 0, 23, 5, 73 }, 160, 52, 140);
+
+    dht11_data_t data;
+    ASSERT_TRUE(dht11_protocol::read(ScriptedLine {}, data));
+    EXPECT_EQ(data.humidity_int, 45);
+    EXPECT_EQ(data.temperature_int, 23);
+    EXPECT_EQ(data.temperature_dec, 5);
+}
+
+TEST(Dht11, ToleratesShortenedHighTimes) {
+    // an interrupt before the high measurement shortens a 1 by 20 us
+    script({ 45, 0, 23, 5, 73 }, 160, 40, 100);
+
+    dht11_data_t data;
+    ASSERT_TRUE(dht11_protocol::read(ScriptedLine {}, data));
+    EXPECT_EQ(data.temperature_int, 23);
+}
+
+TEST(Dht11, RejectsChecksumAndTimeout) {
+    script({ 45, 0, 23, 5, 74 }, 160, 52, 140);
+
+    dht11_data_t data;
+    EXPECT_FALSE(dht11_protocol::read(ScriptedLine {}, data));
+
+    script({ 45, 0, 23, 5, 73 }, 160, 52, 140);
+    ScriptedLine::counts.pop_back();
+    EXPECT_FALSE(dht11_protocol::read(ScriptedLine {}, data));
+}
+
+}
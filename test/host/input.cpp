@@ -0,0 +1,181 @@
+#include "input.h"
+
+#include <gtest/gtest.h>
+#include <microstd/mcu/io.h>
+#include <mock/clock.h>
+#include <stdint.h>
+
+#include <vector>
+
+SIGNAL(INT_PCINT2);
+
+namespace {
+
+using microstd::mcu::io::PCICR;
+using microstd::mcu::io::PCIE2;
+using microstd::mcu::io::PCMSK2;
+using microstd::mcu::io::PIND;
+
+constexpr uint8_t DT     = 1 << 2;
+constexpr uint8_t CLK    = 1 << 3;
+constexpr uint8_t BUTTON = 1 << 4;
+
+/**
+ * @brief Changes the levels of the port D, the pin change interrupt is raised like by the hardware: only for the
+ * enabled pins.
+ */
+void drive(uint8_t bits, bool high) {
+    const uint8_t before = PIND::read();
+    const uint8_t after  = high ? static_cast<uint8_t>(before | bits) : static_cast<uint8_t>(before & ~bits);
+    PIND::write(after);
+
+    if ((PCICR::read() & PCIE2::bit) != 0 && ((before ^ after) & PCMSK2::read()) != 0) {
+        INT_PCINT2();
+    }
+}
+
+/**
+ * @brief One detent of the encoder: CLK leads DT when turned clockwise, DT leads CLK when turned counterclockwise.
+ * Both signals return high, so a detent is two events.
+ */
+void turn(bool clockwise) {
+    const uint8_t first  = clockwise ? CLK : DT;
+    const uint8_t second = clockwise ? DT : CLK;
+
+    drive(first, false);
+    drive(second, false);
+    drive(first, true);
+    drive(second, true);
+}
+
+/**
+ * @brief A DHT11 measurement on the pin: the start signal of the MCU, the response and 40 data bits.
+ *
+ * @param start_ms The length of the start signal, the main loop may read the sensor later than the start time.
+ */
+void dht11_measurement(uint8_t bit, uint32_t start_ms = 19) {
+    drive(bit, false);
+    mock::clock::advance(start_ms);
+    drive(bit, true);
+
+    // response
+    drive(bit, false);
+    drive(bit, true);
+
+    // the data bits, every bit is a low and a high level
+    for (uint8_t i = 0; i < 40; ++i) {
+        drive(bit, false);
+        drive(bit, true);
+    }
+
+    drive(bit, false);
+    drive(bit, true);
+    mock::clock::advance(1);
+}
+
+std::vector<input::Event> take_all() {
+    std::vector<input::Event> events;
+
+    input::Event event;
+    while (input::take(event)) {
+        events.push_back(event);
+    }
+
+    return events;
+}
+
+class InputTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // all pins idle high (the pull-ups and the released DHT11 line)
+        PIND::write(0xFF);
+        PCMSK2::write(0);
+        PCICR::write(0);
+
+        input::init();
+        mock::clock::advance(input::DEBOUNCE_MS);
+        take_all();
+    }
+};
+
+TEST_F(InputTest, InterruptReadsOnlyTheInputPins) { EXPECT_EQ(PCMSK2::read(), input::PORTD_PINS); }
+
+TEST_F(InputTest, ButtonPress) {
+    drive(BUTTON, false);
+    mock::clock::advance(input::DEBOUNCE_MS);
+    drive(BUTTON, true);
+
+    EXPECT_EQ(take_all(), std::vector<input::Event> { input::Event::BUTTON });
+}
+
+TEST_F(InputTest, Dht11MeasurementQueuesNoEvent) {
+    // every free pin of the port D except the USART (PD0, PD1)
+    for (uint8_t pin = 2; pin < 8; ++pin) {
+        const auto bit = static_cast<uint8_t>(1 << pin);
+        if ((input::PORTD_PINS & bit) != 0) {
+            continue;
+        }
+
+        dht11_measurement(bit);
+        EXPECT_TRUE(take_all().empty()) << "DHT11 on PD" << static_cast<int>(pin);
+    }
+}
+
+TEST_F(InputTest, ClockwiseTurnScrollsUp) {
+    turn(true);
+
+    const std::vector<input::Event> expected(2, input::Event::SCROLL_UP);
+    EXPECT_EQ(take_all(), expected);
+}
+
+TEST_F(InputTest, CounterclockwiseTurnScrollsDown) {
+    turn(false);
+
+    const std::vector<input::Event> expected(2, input::Event::SCROLL_DOWN);
+    EXPECT_EQ(take_all(), expected);
+}
+
+TEST_F(InputTest, EncoderBounceQueuesNoEvent) {
+    // the contact bounces around the edge, the transitions cancel out
+    for (uint8_t i = 0; i < 3; ++i) {
+        drive(CLK, false);
+        drive(CLK, true);
+    }
+
+    EXPECT_TRUE(take_all().empty());
+
+    turn(true);
+    EXPECT_EQ(take_all().size(), 2u);
+}
+
+TEST_F(InputTest, InvalidTransitionsQueueNoEvent) {
+    // both signals change between two interrupts
+    drive(CLK | DT, false);
+    drive(CLK | DT, true);
+    drive(CLK | DT, false);
+    drive(CLK | DT, true);
+
+    EXPECT_TRUE(take_all().empty());
+
+    turn(false);
+    const std::vector<input::Event> expected(2, input::Event::SCROLL_DOWN);
+    EXPECT_EQ(take_all(), expected);
+}
+
+TEST_F(InputTest, FullQueueKeepsTheOldestEvents) {
+    // 8 events do not fit into the queue, one slot stays free to tell a full queue from an empty one
+    turn(true);
+    turn(true);
+    turn(true);
+    turn(false);
+
+    std::vector<input::Event> expected(input::QUEUE_SIZE - 2, input::Event::SCROLL_UP);
+    expected.push_back(input::Event::SCROLL_DOWN);
+    EXPECT_EQ(take_all(), expected);
+
+    // the taken events free the queue
+    turn(false);
+    EXPECT_EQ(take_all().size(), 2u);
+}
+
+}
@@ -0,0 +1,379 @@
+#include "component/sensor/ds18b20.h"
+#include "component/sensor/one_wire.h"
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <util/delay.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+using component::sensor::ds18b20;
+using component::sensor::one_wire_crc8;
+using component::sensor::one_wire_rom_t;
+using component::sensor::OneWire;
+
+using scratchpad_t = microstd::types::array_t<uint8_t, 9>;
+
+/**
+ * @brief Simulated 1-Wire bus with DS18B20 probes.
+ *
+ * The devices tell the master pulses apart by their low time like the real ones, the time is the waited time of the
+ * mock delays: a reset (at least 480 us), a written 0 (at least 15 us) or a short slot, which is a written 1 or a read
+ * slot. In a read slot the sending devices pull the line low for a 0, so the line is the AND of all of them.
+ */
+class SimulatedBus {
+public:
+    struct Device {
+        one_wire_rom_t rom;
+        scratchpad_t scratchpad;
+
+        /**
+         * @brief The number of the polled read slots before the conversion is done.
+         */
+        uint8_t conversion_slots = 0;
+    };
+
+    /**
+     * @brief The line is held low, e.g. by a short circuit.
+     */
+    bool stuck_low = false;
+
+    void attach(const Device& device) { m_devices.push_back(State { .device = device }); }
+
+    void pull_low() {
+        m_low       = true;
+        m_low_since = mock::delay::g_elapsed_us;
+    }
+
+    void release() {
+        if (!m_low) {
+            return;
+        }
+
+        m_low = false;
+
+        const double low = mock::delay::g_elapsed_us - m_low_since;
+        if (low >= 480) {
+            reset();
+        } else {
+            slot(low < 15);
+        }
+    }
+
+    [[nodiscard]] bool read() const { return !stuck_low && m_level; }
+
+private:
+    enum class Phase : uint8_t {
+        IDLE,
+        ROM_COMMAND,
+        MATCH_ROM,
+        SEARCH_ROM,
+        FUNCTION_COMMAND,
+        CONVERTING,
+        READ_SCRATCHPAD,
+    };
+
+    struct State {
+        Device device;
+        Phase phase         = Phase::IDLE;
+        uint8_t command     = 0;
+        uint8_t bit         = 0; // the bit of the command, the ROM code or the scratchpad
+        uint8_t search_slot = 0; // the bit, its complement and the direction
+    };
+
+    std::vector<State> m_devices;
+    bool m_low         = false;
+    double m_low_since = 0;
+    bool m_level       = true;
+
+    static bool bit_of(const uint8_t* bytes, uint8_t bit) { return (bytes[bit / 8] & (1 << (bit % 8))) != 0; }
+
+    void reset() {
+        for (State& state : m_devices) {
+            state.phase   = Phase::ROM_COMMAND;
+            state.command = 0;
+            state.bit     = 0;
+        }
+
+        // the presence pulse
+        m_level = m_devices.empty();
+    }
+
+    void slot(bool short_slot) {
+        bool level = true;
+        for (const State& state : m_devices) {
+            if (!output(state)) {
+                level = false;
+            }
+        }
+
+        m_level = level;
+
+        for (State& state : m_devices) {
+            receive(state, short_slot);
+        }
+    }
+
+    /**
+     * @brief The level driven by the device in the slot, a device which does not send leaves the line high.
+     */
+    static bool output(const State& state) {
+        switch (state.phase) {
+        case Phase::SEARCH_ROM:
+            if (state.search_slot == 0) {
+                return bit_of(state.device.rom.data(), state.bit);
+            }
+
+            if (state.search_slot == 1) {
+                return !bit_of(state.device.rom.data(), state.bit);
+            }
+
+            return true;
+        case Phase::CONVERTING:
+            return state.device.conversion_slots == 0;
+        case Phase::READ_SCRATCHPAD:
+            return state.bit >= 72 || bit_of(state.device.scratchpad.data(), state.bit);
+        default:
+            return true;
+        }
+    }
+
+    static void receive(State& state, bool bit) {
+        switch (state.phase) {
+        case Phase::ROM_COMMAND:
+        case Phase::FUNCTION_COMMAND:
+            if (bit) {
+                state.command |= static_cast<uint8_t>(1 << state.bit);
+            }
+
+            if (++state.bit == 8) {
+                command(state);
+            }
+            break;
+        case Phase::MATCH_ROM:
+            if (bit != bit_of(state.device.rom.data(), state.bit)) {
+                state.phase = Phase::IDLE;
+            } else if (++state.bit == 64) {
+                next_command(state, Phase::FUNCTION_COMMAND);
+            }
+            break;
+        case Phase::SEARCH_ROM:
+            if (state.search_slot < 2) {
+                state.search_slot += 1;
+                break;
+            }
+
+            // the devices which do not match the direction leave the search
+            state.search_slot = 0;
+            if (bit != bit_of(state.device.rom.data(), state.bit) || ++state.bit == 64) {
+                state.phase = Phase::IDLE;
+            }
+            break;
+        case Phase::CONVERTING:
+            if (state.device.conversion_slots > 0) {
+                state.device.conversion_slots -= 1;
+            }
+            break;
+        case Phase::READ_SCRATCHPAD:
+            if (state.bit < 72) {
+                state.bit += 1;
+            }
+            break;
+        case Phase::IDLE:
+            break;
+        }
+    }
+
+    static void next_command(State& state, Phase phase) {
+        state.phase   = phase;
+        state.command = 0;
+        state.bit     = 0;
+    }
+
+    static void command(State& state) {
+        if (state.phase == Phase::ROM_COMMAND) {
+            switch (state.command) {
+            case 0xCC: // SKIP ROM
+                next_command(state, Phase::FUNCTION_COMMAND);
+                break;
+            case 0x55: // MATCH ROM
+                next_command(state, Phase::MATCH_ROM);
+                break;
+            case 0xF0: // SEARCH ROM
+                next_command(state, Phase::SEARCH_ROM);
+                state.search_slot = 0;
+                break;
+            default:
+                state.phase = Phase::IDLE;
+                break;
+            }
+
+            return;
+        }
+
+        switch (state.command) {
+        case 0x44: // CONVERT T
+            next_command(state, Phase::CONVERTING);
+            break;
+        case 0xBE: // READ SCRATCHPAD
+            next_command(state, Phase::READ_SCRATCHPAD);
+            break;
+        default:
+            state.phase = Phase::IDLE;
+            break;
+        }
+    }
+};
+
+SimulatedBus g_bus;
+
+struct SimulatedLine {
+    static void release() { g_bus.release(); }
+
+    static void pull_low() { g_bus.pull_low(); }
+
+    static bool read() { return g_bus.read(); }
+};
+
+using bus_t   = OneWire<SimulatedLine>;
+using probe_t = ds18b20<bus_t>;
+
+one_wire_rom_t make_rom(uint8_t family, uint8_t serial_low, uint8_t serial_high) {
+    one_wire_rom_t rom = { family, serial_low, serial_high, 0x00, 0x00, 0x00, 0x00, 0x00 };
+    rom[7]             = one_wire_crc8(rom.data(), 7);
+    return rom;
+}
+
+scratchpad_t make_scratchpad(int16_t raw) {
+    const auto value        = static_cast<uint16_t>(raw);
+    scratchpad_t scratchpad = {
+        static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8), 0x4B, 0x46, 0x7F, 0xFF, 0x0C, 0x10, 0x00,
+    };
+    scratchpad[8] = one_wire_crc8(scratchpad.data(), 8);
+    return scratchpad;
+}
+
+bool contains(const std::vector<one_wire_rom_t>& roms, const one_wire_rom_t& rom) {
+    return std::any_of(roms.begin(), roms.end(), [&rom](const one_wire_rom_t& other) {
+        return std::equal(rom.data(), rom.data() + 8, other.data());
+    });
+}
+
+std::vector<one_wire_rom_t> search() {
+    std::vector<one_wire_rom_t> found;
+
+    bus_t::search_t search;
+    one_wire_rom_t rom;
+    while (search.next(rom)) {
+        found.push_back(rom);
+    }
+
+    return found;
+}
+
+class OneWireTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        g_bus = SimulatedBus {};
+        bus_t::init();
+    }
+};
+
+TEST(OneWireCrc, MaximExample) {
+    // the ROM code of the Maxim application note 27
+    constexpr uint8_t ROM[] = { 0x02, 0x1C, 0xB8, 0x01, 0x00, 0x00, 0x00, 0xA2 };
+
+    EXPECT_EQ(one_wire_crc8(ROM, 7), 0xA2);
+    EXPECT_EQ(one_wire_crc8(ROM, 8), 0x00);
+}
+
+TEST_F(OneWireTest, NoPresenceWithoutDevices) {
+    EXPECT_FALSE(bus_t::reset());
+    EXPECT_TRUE(search().empty());
+}
+
+TEST_F(OneWireTest, SearchFindsAllDevices) {
+    const std::vector<one_wire_rom_t> roms = {
+        make_rom(probe_t::family, 0x01, 0x00),
+        make_rom(probe_t::family, 0x81, 0x00),
+        make_rom(probe_t::family, 0x01, 0x7E),
+        make_rom(0x10, 0xFF, 0xFF),
+    };
+
+    for (const one_wire_rom_t& rom : roms) {
+        g_bus.attach({ .rom = rom, .scratchpad = make_scratchpad(0) });
+    }
+
+    ASSERT_TRUE(bus_t::reset());
+
+    std::vector<one_wire_rom_t> found = search();
+    ASSERT_EQ(found.size(), roms.size());
+
+    for (const one_wire_rom_t& rom : roms) {
+        EXPECT_TRUE(contains(found, rom));
+    }
+}
+
+TEST_F(OneWireTest, SearchRejectsStuckBus) {
+    g_bus.stuck_low = true;
+
+    // the line reads as the all-zero ROM code with a valid CRC
+    EXPECT_TRUE(bus_t::reset());
+    EXPECT_TRUE(search().empty());
+}
+
+TEST_F(OneWireTest, PollsTheConversion) {
+    g_bus.attach({ .rom = make_rom(probe_t::family, 1, 0), .scratchpad = make_scratchpad(0), .conversion_slots = 3 });
+    g_bus.attach({ .rom = make_rom(probe_t::family, 2, 0), .scratchpad = make_scratchpad(0), .conversion_slots = 1 });
+
+    ASSERT_TRUE(probe_t::convert_all());
+
+    // the bus is busy until the slowest probe is done
+    EXPECT_FALSE(probe_t::conversion_done());
+    EXPECT_FALSE(probe_t::conversion_done());
+    EXPECT_FALSE(probe_t::conversion_done());
+    EXPECT_TRUE(probe_t::conversion_done());
+}
+
+TEST_F(OneWireTest, ReadsTheSelectedProbe) {
+    const one_wire_rom_t first  = make_rom(probe_t::family, 1, 0);
+    const one_wire_rom_t second = make_rom(probe_t::family, 2, 0);
+
+    g_bus.attach({ .rom = first, .scratchpad = make_scratchpad(0x0191) });  // 25.0625 C
+    g_bus.attach({ .rom = second, .scratchpad = make_scratchpad(-0x00A2) }); // -10.125 C
+
+    int16_t raw = 0;
+
+    ASSERT_TRUE(probe_t::read(first, raw));
+    EXPECT_EQ(raw, 0x0191);
+    EXPECT_EQ(probe_t::to_tenths(raw), 251);
+
+    ASSERT_TRUE(probe_t::read(second, raw));
+    EXPECT_EQ(raw, -0x00A2);
+    EXPECT_EQ(probe_t::to_tenths(raw), -101);
+}
+
+TEST_F(OneWireTest, RejectsScratchpadCrcFailure) {
+    scratchpad_t scratchpad = make_scratchpad(0x0191);
+    scratchpad[0] ^= 0x04;
+
+    const one_wire_rom_t rom = make_rom(probe_t::family, 1, 0);
+    g_bus.attach({ .rom = rom, .scratchpad = scratchpad });
+
+    int16_t raw = 0x1234;
+    EXPECT_FALSE(probe_t::read(rom, raw));
+    EXPECT_EQ(raw, 0x1234);
+}
+
+TEST_F(OneWireTest, RejectsStuckBusScratchpad) {
+    g_bus.stuck_low = true;
+
+    int16_t raw = 0x1234;
+    EXPECT_FALSE(probe_t::read(make_rom(probe_t::family, 1, 0), raw));
+    EXPECT_EQ(raw, 0x1234);
+}
+
+}
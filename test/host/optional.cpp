@@ -0,0 +1,36 @@
+#include "types/optional.h"
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+namespace {
+
+struct Pair {
+    uint8_t a;
+    int16_t b;
+};
+
+TEST(Optional, None) {
+    constexpr auto value = types::optional_t<uint8_t>::none();
+
+    static_assert(!value.has_value());
+    EXPECT_FALSE(value.has_value());
+}
+
+TEST(Optional, Some) {
+    constexpr auto value = types::optional_t<uint8_t>::some(42);
+
+    static_assert(value.has_value());
+    EXPECT_TRUE(value.has_value());
+    EXPECT_EQ(value.value(), 42);
+}
+
+TEST(Optional, Aggregate) {
+    const auto value = types::optional_t<Pair>::some(Pair { .a = 1, .b = -300 });
+
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(value.value().a, 1);
+    EXPECT_EQ(value.value().b, -300);
+}
+
+}
@@ -0,0 +1,165 @@
+#include "component/sensor/pulse_counter.h"
+#include "types/events.h"
+#include "types/sensor_pin.h"
+#include "types/sensors.h"
+
+#include <gtest/gtest.h>
+#include <microstd/mcu/io.h>
+#include <stdint.h>
+
+namespace {
+
+using component::sensor::BasicSensorInfo;
+using component::sensor::ExternalInterrupt0;
+using component::sensor::PulseCounter;
+using component::sensor::PulseEdge;
+
+namespace io = microstd::mcu::io;
+
+/**
+ * @brief Clock of the edges set by the test, the ticks of `timer_clock_t` (4 us).
+ */
+struct TestClock {
+    static constexpr uint16_t ticks_per_ms = 250;
+
+    static inline uint32_t now = 0;
+
+    static uint32_t ticks() { return now; }
+};
+
+using pin_t     = ::types::SensorPin<io::PORTD2, io::DDRD2, io::PIND2>;
+using counter_t = PulseCounter<ExternalInterrupt0, BasicSensorInfo<pin_t, true>, PulseEdge::RISING, TestClock>;
+
+static_assert(::types::sensor<counter_t>);
+
+/**
+ * @brief An edge on INT0: the hardware sets the flag, the handler runs if the interrupt is enabled.
+ */
+void edge() {
+    uint8_t& flags = io::mock::data_space[io::EIFR::address];
+    flags |= io::INTF0::bit;
+
+    if (io::INT0::is_set()) {
+        flags = 0;
+        counter_t::on_edge();
+    }
+}
+
+/**
+ * @brief Enabling the interrupt with its flag set runs the handler, clearing the flag (writing 1) resets it.
+ */
+void eifr_written(uint8_t value) {
+    if ((value & io::INTF0::bit) != 0) {
+        io::mock::data_space[io::EIFR::address] = 0;
+    }
+}
+
+void eimsk_written(uint8_t value) {
+    if ((value & io::INT0::bit) != 0 && io::INTF0::is_set()) {
+        io::mock::data_space[io::EIFR::address] = 0;
+        counter_t::on_edge();
+    }
+}
+
+/**
+ * @brief Edges at the period in ticks.
+ */
+void edges(uint16_t count, uint32_t period) {
+    for (uint16_t i = 0; i < count; ++i) {
+        TestClock::now += period;
+        edge();
+    }
+}
+
+class PulseCounterTest : public ::testing::Test {
+protected:
+    ::types::SensorsCollection<2, counter_t> m_sensors;
+    ::types::EventQueue<4> m_events;
+
+    void SetUp() override {
+        TestClock::now = 0;
+        io::EIFR::write(0);
+        io::EIMSK::write(0);
+        io::EIFR::on_write  = eifr_written;
+        io::EIMSK::on_write = eimsk_written;
+
+        m_sensors.init();
+    }
+
+    void TearDown() override {
+        io::EIFR::on_write  = nullptr;
+        io::EIMSK::on_write = nullptr;
+    }
+
+    component::sensor::pulse_data_t measure() {
+        m_sensors.measure_all(m_events, 0);
+        return m_sensors.measure<0>(0);
+    }
+};
+
+TEST_F(PulseCounterTest, ConfiguresTheInterrupt) {
+    EXPECT_TRUE(io::INT0::is_set());
+    EXPECT_TRUE(io::ISC00::is_set());
+    EXPECT_TRUE(io::ISC01::is_set());
+    EXPECT_TRUE(io::PORTD2::is_set());
+
+    m_sensors.disable(0);
+    EXPECT_FALSE(io::INT0::is_set());
+}
+
+TEST_F(PulseCounterTest, MeasuresTheFrequency) {
+    // 11 edges at 1 kHz
+    edges(11, 250);
+
+    const auto data = measure();
+    EXPECT_EQ(data.count, 11);
+    EXPECT_EQ(data.period, 1000U);
+    EXPECT_EQ(data.frequency, 1000000U);
+}
+
+TEST_F(PulseCounterTest, ResolvesPeriodsBelowAMillisecond) {
+    // 5 kHz and 3.2 kHz, the edges are 50 and 78 ticks apart
+    edges(100, 50);
+
+    auto data = measure();
+    EXPECT_EQ(data.count, 100);
+    EXPECT_EQ(data.period, 200U);
+    EXPECT_EQ(data.frequency, 5000000U);
+
+    edges(33, 78);
+
+    data = measure();
+    EXPECT_EQ(data.period, 312U);
+    EXPECT_EQ(data.frequency, 3205128U);
+}
+
+TEST_F(PulseCounterTest, RestartsAfterTheMeasurement) {
+    edges(5, 250);
+    EXPECT_EQ(measure().count, 5);
+
+    // a single edge in 1 s: the frequency over the whole interval
+    TestClock::now += 250U * 500;
+    edge();
+    TestClock::now += 250U * 500;
+
+    const auto data = measure();
+    EXPECT_EQ(data.count, 1);
+    EXPECT_EQ(data.period, 0U);
+    EXPECT_EQ(data.frequency, 1000U);
+}
+
+TEST_F(PulseCounterTest, IgnoresEdgesBeforeTheEnable) {
+    m_sensors.disable(0);
+
+    // the flag of the edge stays set while the interrupt is disabled
+    edges(3, 250);
+    EXPECT_TRUE(io::INTF0::is_set());
+
+    m_sensors.enable(0);
+    EXPECT_FALSE(io::INTF0::is_set());
+
+    edges(2, 250);
+    EXPECT_EQ(measure().count, 2);
+}
+
+}
@@ -0,0 +1,452 @@
+#include "types/calibration.h"
+#include "types/events.h"
+#include "types/fields.h"
+#include "types/format.h"
+#include "types/sensor_array.h"
+#include "types/sensor_meta.h"
+#include "types/sensors.h"
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+#include <util/delay.h>
+
+#include <vector>
+
+namespace {
+
+using types::SensorBase;
+using types::SensorFlags;
+
+struct LevelData {
+    int16_t level;
+};
+
+using level_fields_t = types::fields<&LevelData::level>;
+
+/**
+ * @brief Sensor returning the value set by the test, `FAIL` makes the measurement fail.
+ */
+template <uint16_t DedupBand = 0, SensorFlags Flags = SensorFlags::NONE> struct ScriptedSensor
+    : SensorBase<LevelData, Flags, level_fields_t> {
+    using optional_data_t = typename SensorBase<LevelData, Flags, level_fields_t>::optional_data_t;
+
+    static constexpr int16_t FAIL       = -32768;
+    static constexpr uint16_t dedup_band = DedupBand;
+
+    static inline int16_t next = 0;
+
+    static optional_data_t measure() {
+        if (next == FAIL) {
+            return optional_data_t::none();
+        }
+
+        return optional_data_t::some(LevelData { .level = next });
+    }
+};
+
+using plain_t   = ScriptedSensor<>;
+using dedup_t   = ScriptedSensor<2, SensorFlags::HAS_DEDUP>;
+using collection_t = types::SensorsCollection<4, plain_t, dedup_t>;
+
+class SensorsTest : public ::testing::Test {
+protected:
+    collection_t m_sensors;
+    types::EventQueue<4> m_events;
+
+    void SetUp() override {
+        plain_t::next = 0;
+        dedup_t::next = 0;
+        m_sensors.init();
+    }
+
+    void measure(int16_t plain, int16_t dedup) {
+        plain_t::next = plain;
+        dedup_t::next = dedup;
+        m_sensors.measure_all(m_events, 0);
+    }
+};
+
+TEST_F(SensorsTest, CachesTheLatestMeasurements) {
+    for (int16_t i = 1; i <= 3; ++i) {
+        measure(i, static_cast<int16_t>(i * 10));
+    }
+
+    EXPECT_EQ(m_sensors.samples<0>(), 3);
+    EXPECT_EQ(m_sensors.measure<0>(0).level, 3);
+    EXPECT_EQ(m_sensors.measure<0>(2).level, 1);
+}
+
+TEST_F(SensorsTest, DropsTheOldestMeasurement) {
+    for (int16_t i = 1; i <= 6; ++i) {
+        measure(i, static_cast<int16_t>(i * 10));
+    }
+
+    EXPECT_EQ(m_sensors.samples<0>(), 4);
+    EXPECT_EQ(m_sensors.samples<1>(), 4);
+
+    for (uint8_t age = 0; age < 4; ++age) {
+        EXPECT_EQ(m_sensors.measure<0>(age).level, 6 - age);
+        EXPECT_EQ(m_sensors.measure<1>(age).level, (6 - age) * 10);
+    }
+}
+
+TEST_F(SensorsTest, ReadsRawBytes) {
+    measure(0x1234, 0);
+
+    uint8_t bytes[2] = {};
+    ASSERT_TRUE(m_sensors.read_raw(0, 0, 0, sizeof(bytes), bytes));
+
+    // the data is copied in the memory order
+    int16_t value;
+    __builtin_memcpy(&value, bytes, sizeof(value));
+    EXPECT_EQ(value, 0x1234);
+
+    EXPECT_FALSE(m_sensors.read_raw(0, 1, 0, sizeof(bytes), bytes));
+    EXPECT_FALSE(m_sensors.read_raw(0, 0, 1, sizeof(bytes), bytes));
+}
+
+TEST_F(SensorsTest, SkipsDisabledSensors) {
+    measure(1, 10);
+
+    m_sensors.disable(0);
+    EXPECT_FALSE(m_sensors.is_enabled(0));
+
+    measure(2, 20);
+
+    EXPECT_EQ(m_sensors.samples<0>(), 1);
+    EXPECT_EQ(m_sensors.measure<0>(0).level, 1);
+    EXPECT_EQ(m_sensors.samples<1>(), 2);
+}
+
+TEST_F(SensorsTest, CountsRepeatsWithinTheBand) {
+    measure(0, 100);
+    measure(0, 101);
+    measure(0, 98);
+    measure(0, 103);
+
+    // 101 and 98 are within 2 of 100, 103 is not
+    EXPECT_EQ(m_sensors.samples<1>(), 2);
+    EXPECT_EQ(m_sensors.measure<1>(1).level, 100);
+    EXPECT_EQ(m_sensors.repeats<1>(1), 2);
+    EXPECT_EQ(m_sensors.measure<1>(0).level, 103);
+    EXPECT_EQ(m_sensors.repeats<1>(0), 0);
+
+    // the plain sensor caches every measurement
+    EXPECT_EQ(m_sensors.samples<0>(), 4);
+    EXPECT_EQ(m_sensors.repeats<0>(0), 0);
+}
+
+TEST_F(SensorsTest, SaturatesTheRepeats) {
+    for (uint16_t i = 0; i < 300; ++i) {
+        measure(0, 50);
+    }
+
+    // the saturated measurement is cached again
+    EXPECT_EQ(m_sensors.samples<1>(), 2);
+    EXPECT_EQ(m_sensors.repeats<1>(1), 0xFF);
+    EXPECT_EQ(m_sensors.repeats<1>(0), 300 - 256 - 1);
+}
+
+TEST_F(SensorsTest, CachesCalibratedValues) {
+    types::calibration_t calibration;
+    ASSERT_TRUE(types::calibration_t::make(0, 3, -2, 2, calibration));
+
+    ASSERT_TRUE(m_sensors.set_calibration(0, 0, calibration));
+    EXPECT_FALSE(m_sensors.set_calibration(0, 1, calibration));
+    EXPECT_FALSE(m_sensors.set_calibration(collection_t::sensors_count, 0, calibration));
+
+    measure(10, 10);
+
+    EXPECT_EQ(m_sensors.measure<0>(0).level, 13);
+    EXPECT_EQ(m_sensors.measure<1>(0).level, 10);
+}
+
+TEST_F(SensorsTest, DeduplicatesCalibratedValues) {
+    types::calibration_t calibration;
+    ASSERT_TRUE(types::calibration_t::make(0, 10, 0, 1, calibration));
+    ASSERT_TRUE(m_sensors.set_calibration(1, 0, calibration));
+
+    // 10 and 11 are within the band before the calibration, 100 and 110 are not
+    measure(0, 10);
+    measure(0, 11);
+
+    EXPECT_EQ(m_sensors.samples<1>(), 2);
+}
+
+TEST_F(SensorsTest, RecordsFailures) {
+    measure(plain_t::FAIL, 1);
+    measure(plain_t::FAIL, 1);
+    measure(5, 1);
+    measure(plain_t::FAIL, 1);
+
+    const types::sensor_stats_t& stats = m_sensors.stats(0);
+    EXPECT_EQ(stats.successes, 1);
+    EXPECT_EQ(stats.failures, 3);
+    EXPECT_EQ(stats.consecutive_failures, 1);
+
+    EXPECT_EQ(m_sensors.samples<0>(), 1);
+    EXPECT_EQ(m_sensors.stats(1).successes, 4);
+}
+
+TEST(SensorStats, ReportsTheDurations) {
+    types::sensor_stats_t stats;
+    EXPECT_EQ(stats.min_duration(), 0);
+    EXPECT_EQ(stats.avg_duration(), 0);
+    EXPECT_EQ(stats.max_duration(), 0);
+
+    stats.record_duration(10);
+    stats.record_duration(30);
+    stats.record_duration(20);
+
+    EXPECT_EQ(stats.min_duration(), 10);
+    EXPECT_EQ(stats.avg_duration(), 20);
+    EXPECT_EQ(stats.max_duration(), 30);
+}
+
+/**
+ * @brief Array driver with the metadata, the arrays of one and two pins are named by the collection.
+ */
+struct NamedDriver : SensorBase<LevelData, SensorFlags::NONE, level_fields_t> {
+    static constexpr types::sensor_meta_t meta PROGMEM = { .name = "level" };
+
+    static constexpr types::field_meta_t fields_meta[] PROGMEM = {
+        SENSOR_FIELD(LevelData, level, "", 0),
+    };
+
+    static optional_data_t measure(const types::sensor_instance_t&) {
+        return optional_data_t::some(LevelData { .level = 0 });
+    }
+};
+
+constexpr types::io_pin_t PD5 = { types::Port::D, 5 };
+constexpr types::io_pin_t PD6 = { types::Port::D, 6 };
+
+using single_t = types::SensorArray<NamedDriver, PD5>;
+using pair_t   = types::SensorArray<NamedDriver, PD5, PD6>;
+
+TEST(SensorNames, NumbersOnlyTheInstancesOfLargerArrays) {
+    using named_t = types::SensorsCollection<1, single_t, pair_t>;
+
+    constexpr const char* EXPECTED[] = { "level", "level#0", "level#1" };
+
+    for (uint8_t id = 0; id < named_t::sensors_count; ++id) {
+        char name[16];
+        types::text_writer_t out(name, sizeof(name));
+
+        named_t::format_name(id, out);
+        EXPECT_STREQ(name, EXPECTED[id]);
+    }
+}
+
+/**
+ * @brief A call of a sensor function and the time of the call in microseconds (the time waited by the mock delays).
+ */
+struct Call {
+    char sensor;
+    char function; // 'E'nable, 'D'isable or 'M'easure
+    double at;
+};
+
+std::vector<Call> g_calls;
+
+uint32_t count_calls(char sensor, char function) {
+    uint32_t result = 0;
+    for (const Call& call : g_calls) {
+        if (call.sensor == sensor && call.function == function) {
+            result += 1;
+        }
+    }
+
+    return result;
+}
+
+const Call* find_call(char sensor, char function) {
+    for (const Call& call : g_calls) {
+        if (call.sensor == sensor && call.function == function) {
+            return &call;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Sensor logging the calls of its functions.
+ */
+template <char Name, SensorFlags Flags, uint16_t WarmUp = 0, uint16_t MaxAge = 0> struct LoggedSensor
+    : SensorBase<LevelData, SensorFlags::HAS_ENABLE | Flags, level_fields_t> {
+    using base_t          = SensorBase<LevelData, SensorFlags::HAS_ENABLE | Flags, level_fields_t>;
+    using optional_data_t = typename base_t::optional_data_t;
+
+    static constexpr uint16_t warm_up = WarmUp;
+    static constexpr uint16_t max_age = MaxAge;
+
+    static inline bool fail = false;
+
+    static optional_data_t measure() {
+        log('M');
+        if (fail) {
+            return optional_data_t::none();
+        }
+
+        return optional_data_t::some(LevelData { .level = 1 });
+    }
+
+    static void enable() { log('E'); }
+
+    static void disable() { log('D'); }
+
+private:
+    static void log(char function) {
+        g_calls.push_back({ .sensor = Name, .function = function, .at = mock::delay::g_elapsed_us });
+    }
+};
+
+using lazy_t      = LoggedSensor<'L', SensorFlags::LAZY, 0, 10>;
+using short_t     = LoggedSensor<'S', SensorFlags::POWER_CYCLE, 30>;
+using long_t      = LoggedSensor<'W', SensorFlags::POWER_CYCLE, 80>;
+using lazy_cycled = LoggedSensor<'C', SensorFlags::LAZY | SensorFlags::POWER_CYCLE, 20, 10>;
+
+class ScheduleTest : public ::testing::Test {
+protected:
+    types::EventQueue<4> m_events;
+
+    void SetUp() override {
+        g_calls.clear();
+        mock::delay::g_elapsed_us = 0;
+        lazy_t::fail              = false;
+    }
+
+    /**
+     * @brief Runs the schedule of the main loop: the sensors are powered up in 10 ms steps before the measurement.
+     */
+    template <typename Collection> void run_cycle(Collection& sensors, uint32_t interval) {
+        for (uint32_t remaining = interval; remaining > 0; remaining -= 10) {
+            sensors.power_up(remaining);
+            _delay_ms(10);
+        }
+
+        sensors.measure_all(m_events, 0);
+        sensors.power_down();
+    }
+};
+
+TEST_F(ScheduleTest, MeasuresLazySensorsOnlyWhenStale) {
+    types::SensorsCollection<4, lazy_t> sensors;
+    sensors.init();
+
+    // the periodic measurement skips the lazy sensor
+    sensors.measure_all(m_events, 0);
+    EXPECT_EQ(count_calls('L', 'M'), 0);
+
+    sensors.refresh(0, m_events, 100);
+    EXPECT_EQ(count_calls('L', 'M'), 1);
+
+    // younger than the max age (10 s)
+    sensors.refresh(0, m_events, 105);
+    sensors.refresh(0, m_events, 109);
+    EXPECT_EQ(count_calls('L', 'M'), 1);
+
+    sensors.refresh(0, m_events, 110);
+    EXPECT_EQ(count_calls('L', 'M'), 2);
+    EXPECT_EQ(sensors.samples<0>(), 2);
+
+    // a failed measurement keeps the cache and is retried by the next read
+    lazy_t::fail = true;
+    sensors.refresh(0, m_events, 120);
+    sensors.refresh(0, m_events, 121);
+    EXPECT_EQ(count_calls('L', 'M'), 4);
+    EXPECT_EQ(sensors.samples<0>(), 2);
+
+    // a disabled sensor is not measured
+    lazy_t::fail = false;
+    sensors.disable(0);
+    sensors.refresh(0, m_events, 200);
+    EXPECT_EQ(count_calls('L', 'M'), 4);
+}
+
+TEST_F(ScheduleTest, WarmsUpBeforeTheMeasurement) {
+    types::SensorsCollection<4, short_t> sensors;
+    sensors.init();
+
+    // the enable command does not power the sensor
+    EXPECT_EQ(count_calls('S', 'E'), 0);
+
+    run_cycle(sensors, 100);
+
+    ASSERT_EQ(g_calls.size(), 3U);
+    EXPECT_EQ(g_calls[0].function, 'E');
+    EXPECT_EQ(g_calls[1].function, 'M');
+    EXPECT_EQ(g_calls[2].function, 'D');
+
+    EXPECT_DOUBLE_EQ(g_calls[1].at - g_calls[0].at, 30 * 1000);
+    EXPECT_DOUBLE_EQ(g_calls[2].at, g_calls[1].at);
+}
+
+TEST_F(ScheduleTest, WaitsForALateWarmUp) {
+    types::SensorsCollection<4, short_t> sensors;
+    sensors.init();
+
+    // no scheduled power up, e.g. the sensor was enabled right before the measurement
+    sensors.measure_all(m_events, 0);
+    sensors.power_down();
+
+    ASSERT_EQ(g_calls.size(), 3U);
+    EXPECT_EQ(g_calls[0].function, 'E');
+    EXPECT_DOUBLE_EQ(g_calls[1].at - g_calls[0].at, 30 * 1000);
+    EXPECT_EQ(g_calls[2].function, 'D');
+}
+
+TEST_F(ScheduleTest, OverlapsTheWarmUps) {
+    types::SensorsCollection<4, short_t, long_t> sensors;
+    sensors.init();
+
+    run_cycle(sensors, 100);
+
+    const Call* short_on  = find_call('S', 'E');
+    const Call* long_on   = find_call('W', 'E');
+    const Call* short_off = find_call('S', 'D');
+    const Call* long_off  = find_call('W', 'D');
+    ASSERT_TRUE(short_on && long_on && short_off && long_off);
+
+    // the longer warm-up starts first and both end at the measurement, which does not wait
+    EXPECT_DOUBLE_EQ(long_on->at, 20 * 1000);
+    EXPECT_DOUBLE_EQ(short_on->at, 70 * 1000);
+    EXPECT_DOUBLE_EQ(find_call('S', 'M')->at, 100 * 1000);
+    EXPECT_DOUBLE_EQ(find_call('W', 'M')->at, 100 * 1000);
+
+    // both sensors are powered during the shorter warm-up
+    EXPECT_LT(long_on->at, short_on->at);
+    EXPECT_GT(long_off->at, short_on->at);
+}
+
+TEST_F(ScheduleTest, DisabledSensorIsNotPowered) {
+    types::SensorsCollection<4, short_t> sensors;
+    sensors.init();
+
+    sensors.power_up(10);
+    sensors.disable(0);
+    EXPECT_EQ(count_calls('S', 'D'), 1);
+
+    run_cycle(sensors, 100);
+    EXPECT_EQ(count_calls('S', 'E'), 1);
+    EXPECT_EQ(count_calls('S', 'M'), 0);
+}
+
+TEST_F(ScheduleTest, PowerCyclesLazyReads) {
+    types::SensorsCollection<4, lazy_cycled> sensors;
+    sensors.init();
+
+    // the lazy sensor is not powered by the schedule, only around the read
+    run_cycle(sensors, 100);
+    EXPECT_TRUE(g_calls.empty());
+
+    sensors.refresh(0, m_events, 100);
+
+    ASSERT_EQ(g_calls.size(), 3U);
+    EXPECT_EQ(g_calls[0].function, 'E');
+    EXPECT_DOUBLE_EQ(g_calls[1].at - g_calls[0].at, 20 * 1000);
+    EXPECT_EQ(g_calls[2].function, 'D');
+}
+
+}
@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+
+import os
+import sys
+import shutil
+import argparse
+import subprocess
+
+# .data and .bss are placed at the start of the SRAM, the rest is shared by the heap and the stack
+SRAM_SECTIONS = [".data", ".bss", ".noinit"]
+
+def print_err(msg: str):
+    print(f"\x1b[31mERROR: {msg}\x1b[0m", file=sys.stderr)
+
+
+def run(command: list[str]) -> str:
+    try:
+        return subprocess.run(command, check=True, text=True, capture_output=True).stdout
+    except (OSError, subprocess.CalledProcessError) as e:
+        print_err(f"'{' '.join(command)}' failed")
+        print(getattr(e, "stderr", str(e)), file=sys.stderr)
+        sys.exit(1)
+
+
+def section_sizes(size_tool: str, file: str) -> dict[str, int]:
+    sizes = {}
+
+    # avr-size -A prints "<section> <size> <address>"
+    for line in run([size_tool, "-A", file]).splitlines():
+        parts = line.split()
+        if len(parts) == 3 and parts[0] in SRAM_SECTIONS:
+            sizes[parts[0]] = int(parts[1])
+
+    return sizes
+
+
+def data_symbols(nm_tool: str, file: str) -> list[tuple[int, str]]:
+    symbols = []
+
+    # avr-nm -S prints "<address> <size> <type> <name>", the read-only data (r, R) is also linked into .data
+    for line in run([nm_tool, "-S", "-t", "d", "--size-sort", file]).splitlines():
+        parts = line.split(maxsplit=3)
+        if len(parts) == 4 and parts[2] in ("d", "D", "r", "R"):
+            symbols.append((int(parts[1]), parts[3]))
+
+    return sorted(symbols, reverse=True)
+
+
+def report(args: argparse.Namespace):
+    sizes = section_sizes(args.size_tool, args.file)
+    used = sum(sizes.values())
+    free = args.sram - used
+
+    print("SRAM:")
+    for section in SRAM_SECTIONS:
+        print(f"  {section:8} {sizes.get(section, 0):6} B")
+    print(f"  {'used':8} {used:6} B")
+    print(f"  {'free':8} {free:6} B (stack and the locals of main)")
+
+    # string literals and the other constants without a symbol are copied to .data at startup
+    symbols = data_symbols(args.nm_tool, args.file)
+    unnamed = max(sizes.get(".data", 0) - sum(size for size, _ in symbols), 0)
+    print(f"  literals {unnamed:6} B in .data without a symbol")
+
+    for size, name in symbols[:args.top]:
+        print(f"    {size:6} B {name}")
+
+    if args.baseline is None or not os.path.isfile(args.baseline):
+        return
+
+    baseline = sum(section_sizes(args.size_tool, args.baseline).values())
+    reclaimed = baseline - used
+    print(f"  reclaimed {reclaimed:5} B against {args.baseline}")
+
+    if args.sample_size is not None and args.sample_size > 0 and reclaimed > 0:
+        print(f"  CacheSize can grow by {reclaimed // args.sample_size} samples of {args.sample_size} B")
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Reports the static SRAM usage of an AVR firmware")
+
+    parser.add_argument("-f", "--file", type=str, help="ELF file", required=True)
+    parser.add_argument("--baseline", type=str, help="ELF file of the previous firmware", required=False)
+    parser.add_argument("--save", type=str, help="Copies the ELF file as the next baseline", required=False)
+    parser.add_argument("--sram", type=int, help="SRAM size in bytes", default=2048)
+    parser.add_argument("--sample-size", type=int, help="Bytes of one cached sample (SensorsCollection::sample_size)",
+                        required=False)
+    parser.add_argument("--top", type=int, help="Number of the largest .data symbols listed", default=5)
+    parser.add_argument("--size-tool", type=str, help="avr-size executable", default="avr-size")
+    parser.add_argument("--nm-tool", type=str, help="avr-nm executable", default="avr-nm")
+
+    args = parser.parse_args()
+
+    if not os.path.isfile(args.file):
+        print_err(f"File '{args.file}' not found")
+        sys.exit(1)
+
+    report(args)
+
+    if args.save is not None:
+        shutil.copyfile(args.file, args.save)